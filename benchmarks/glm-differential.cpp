@@ -0,0 +1,272 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+// runs the same randomized inputs through micro::math and the bundled glm, reports the largest absolute and ULP error
+// of micro::math against glm and the time per operation of both, exits with a failure if any error is over tolerance
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <micro-engine/mathematics.h>
+#include <micro-engine/performance/suite.h>
+
+using namespace micro::core;
+using namespace micro::math;
+
+namespace {
+    constexpr usize samples = 4096;
+    constexpr usize repeats = 64;
+
+    struct Sample {
+        vector4<f32>    v0, v1;
+        vector3<f32>    u0, u1, axis;
+        matrix3x3<f32>  n0;
+        matrix4x4<f32>  m0, m1;
+        quaternion<f32> q0, q1;
+        f32             angle, fov, aspect, zNear, zFar;
+
+        glm::vec4 gv0, gv1;
+        glm::vec3 gu0, gu1, gaxis;
+        glm::mat3 gn0;
+        glm::mat4 gm0, gm1;
+        glm::quat gq0, gq1;
+    };
+
+    template<usize C, usize R>
+    fn toGlm(matrix<C, R, f32> const &mat) -> glm::mat<C, R, f32> {
+        glm::mat<C, R, f32> res{};
+        for (usize c = 0; c < C; ++c)
+            for (usize r = 0; r < R; ++r)
+                res[c][r] = mat[c][r];
+        return res;
+    }
+
+    fn generate(usize count) -> std::vector<Sample> {
+        std::mt19937                          engine{20261019};
+        std::uniform_real_distribution<f32> unit{-1.f, 1.f};
+
+        auto const v3 = [&]() { return vector3<f32>{unit(engine), unit(engine), unit(engine)}; };
+        auto const v4 = [&]() { return vector4<f32>{unit(engine), unit(engine), unit(engine), unit(engine)}; };
+
+        std::vector<Sample> res(count);
+        for (auto &s : res) {
+            s.v0   = v4();
+            s.v1   = v4();
+            s.u0   = v3() * 10.f;
+            s.u1   = v3() * 10.f + vector3<f32>{0.f, 0.f, 25.f};
+            s.axis = v3() + vector3<f32>{0.f, 0.f, 1.5f};
+
+            // diagonally dominant, so the inverses are well conditioned
+            s.n0 = matrix3x3<f32>{v3(), v3(), v3()} + matrix3x3<f32>{4.f};
+            s.m0 = matrix4x4<f32>{v4(), v4(), v4(), v4()} + matrix4x4<f32>{4.f};
+            s.m1 = matrix4x4<f32>{v4(), v4(), v4(), v4()};
+
+            s.q0 = normalize(quaternion<f32>{unit(engine), unit(engine), unit(engine), unit(engine)});
+            s.q1 = normalize(quaternion<f32>{unit(engine), unit(engine), unit(engine), unit(engine)});
+
+            s.angle  = unit(engine) * std::numbers::pi_v<f32>;
+            s.fov    = radians(30.f + 60.f * (unit(engine) + 1.f) / 2.f);
+            s.aspect = 0.5f + (unit(engine) + 1.f);
+            s.zNear  = 0.1f + (unit(engine) + 1.f) / 2.f;
+            s.zFar   = s.zNear + 10.f + 100.f * (unit(engine) + 1.f);
+
+            s.gv0   = glm::vec4{s.v0.x, s.v0.y, s.v0.z, s.v0.w};
+            s.gv1   = glm::vec4{s.v1.x, s.v1.y, s.v1.z, s.v1.w};
+            s.gu0   = glm::vec3{s.u0.x, s.u0.y, s.u0.z};
+            s.gu1   = glm::vec3{s.u1.x, s.u1.y, s.u1.z};
+            s.gaxis = glm::vec3{s.axis.x, s.axis.y, s.axis.z};
+            s.gn0   = toGlm(s.n0);
+            s.gm0   = toGlm(s.m0);
+            s.gm1   = toGlm(s.m1);
+            s.gq0   = glm::quat{s.q0.s, s.q0.x, s.q0.y, s.q0.z};
+            s.gq1   = glm::quat{s.q1.s, s.q1.x, s.q1.y, s.q1.z};
+        }
+        return res;
+    }
+
+    // flattens results of either library into their scalar components, matrices column by column
+    fn flatten(f32 value) -> std::vector<f32> { return {value}; }
+
+    template<usize L>
+    fn flatten(vector<L, f32> const &vec) -> std::vector<f32> {
+        std::vector<f32> res(L);
+        for (usize i = 0; i < L; ++i)
+            res[i] = vec[i];
+        return res;
+    }
+
+    template<usize C, usize R>
+    fn flatten(matrix<C, R, f32> const &mat) -> std::vector<f32> {
+        std::vector<f32> res{};
+        for (usize c = 0; c < C; ++c)
+            for (usize r = 0; r < R; ++r)
+                res.push_back(mat[c][r]);
+        return res;
+    }
+
+    fn flatten(quaternion<f32> const &quat) -> std::vector<f32> { return {quat.s, quat.x, quat.y, quat.z}; }
+
+    template<glm::length_t L>
+    fn flatten(glm::vec<L, f32> const &vec) -> std::vector<f32> {
+        std::vector<f32> res(L);
+        for (glm::length_t i = 0; i < L; ++i)
+            res[i] = vec[i];
+        return res;
+    }
+
+    template<glm::length_t C, glm::length_t R>
+    fn flatten(glm::mat<C, R, f32> const &mat) -> std::vector<f32> {
+        std::vector<f32> res{};
+        for (glm::length_t c = 0; c < C; ++c)
+            for (glm::length_t r = 0; r < R; ++r)
+                res.push_back(mat[c][r]);
+        return res;
+    }
+
+    fn flatten(glm::quat const &quat) -> std::vector<f32> { return {quat.w, quat.x, quat.y, quat.z}; }
+
+    // distance in representable floats, sign-magnitude bits mapped onto a monotonic integer line
+    fn ulps(f32 a, f32 b) -> u64 {
+        if (std::isnan(a) || std::isnan(b))
+            return std::numeric_limits<u64>::max();
+
+        auto const ordered = [](f32 value) {
+            auto const bits = std::bit_cast<i32>(value);
+            return bits < 0 ? static_cast<i64>(std::numeric_limits<i32>::min()) - bits : static_cast<i64>(bits);
+        };
+        auto const diff = ordered(a) - ordered(b);
+        return static_cast<u64>(diff < 0 ? -diff : diff);
+    }
+
+    template<typename Op>
+    fn time(std::vector<Sample> const &inputs, Op &&op) {
+        std::vector<decltype(op(inputs.front()))> outputs(inputs.size());
+
+        auto const start = std::chrono::steady_clock::now();
+        for (usize r = 0; r < repeats; ++r) {
+            for (usize i = 0; i < inputs.size(); ++i)
+                outputs[i] = op(inputs[i]);
+            // keeps the timed loops from being merged or dropped across repeats
+            micro::perf::clobber();
+        }
+        auto const end = std::chrono::steady_clock::now();
+
+        auto const ns = static_cast<f64>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) /
+                        static_cast<f64>(repeats * inputs.size());
+        return std::make_pair(std::move(outputs), ns);
+    }
+
+    // relative tolerance, measured against max(1, |glm|) so values near zero are compared absolutely
+    template<typename MicroOp, typename GlmOp>
+    fn compare(cstring name, std::vector<Sample> const &inputs, f64 tolerance, MicroOp &&microOp, GlmOp &&glmOp) -> bool {
+        auto const [microOut, microNs] = time(inputs, microOp);
+        auto const [glmOut, glmNs]     = time(inputs, glmOp);
+
+        f64 maxAbs = 0.;
+        f64 maxRel = 0.;
+        u64 maxUlp = 0;
+        for (usize i = 0; i < inputs.size(); ++i) {
+            auto const a = flatten(microOut[i]);
+            auto const b = flatten(glmOut[i]);
+            for (usize j = 0; j < a.size(); ++j) {
+                auto const err = std::abs(static_cast<f64>(a[j]) - static_cast<f64>(b[j]));
+                maxAbs = std::max(maxAbs, err);
+                maxRel = std::max(maxRel, err / std::max(1., std::abs(static_cast<f64>(b[j]))));
+                maxUlp = std::max(maxUlp, ulps(a[j], b[j]));
+            }
+        }
+
+        auto const ok = maxRel <= tolerance;
+        std::printf("%-24s %12.3e %12llu %10.2f %10.2f %8.2fx  %s\n",
+                    name, maxAbs, static_cast<unsigned long long>(maxUlp), microNs, glmNs, microNs / glmNs,
+                    ok ? "ok" : "FAIL");
+        return ok;
+    }
+}
+
+auto main() -> int {
+    auto const inputs = generate(samples);
+
+    std::printf("%zu samples x %zu repeats, errors of micro::math relative to glm\n\n", samples, repeats);
+    std::printf("%-24s %12s %12s %10s %10s %9s\n", "operation", "max abs", "max ulp", "micro ns", "glm ns", "ratio");
+
+    auto ok = true;
+
+    ok &= compare("vector4 add", inputs, 1e-6,
+                  [](Sample const &s) { return s.v0 + s.v1; },
+                  [](Sample const &s) { return s.gv0 + s.gv1; });
+    ok &= compare("vector4 scale", inputs, 1e-6,
+                  [](Sample const &s) { return s.v0 * s.angle; },
+                  [](Sample const &s) { return s.gv0 * s.angle; });
+    ok &= compare("vector4 dot", inputs, 1e-6,
+                  [](Sample const &s) { return dot(s.v0, s.v1); },
+                  [](Sample const &s) { return glm::dot(s.gv0, s.gv1); });
+    ok &= compare("vector3 cross", inputs, 1e-6,
+                  [](Sample const &s) { return cross(s.u0, s.u1); },
+                  [](Sample const &s) { return glm::cross(s.gu0, s.gu1); });
+    ok &= compare("vector3 normalize", inputs, 1e-6,
+                  [](Sample const &s) { return normalize(s.u0); },
+                  [](Sample const &s) { return glm::normalize(s.gu0); });
+
+    ok &= compare("matrix4x4 * vector4", inputs, 1e-6,
+                  [](Sample const &s) { return s.m0 * s.v0; },
+                  [](Sample const &s) { return s.gm0 * s.gv0; });
+    ok &= compare("matrix4x4 * matrix4x4", inputs, 1e-6,
+                  [](Sample const &s) { return s.m0 * s.m1; },
+                  [](Sample const &s) { return s.gm0 * s.gm1; });
+    ok &= compare("matrix4x4 transpose", inputs, 1e-6,
+                  [](Sample const &s) { return transpose(s.m0); },
+                  [](Sample const &s) { return glm::transpose(s.gm0); });
+    ok &= compare("matrix3x3 determinant", inputs, 1e-5,
+                  [](Sample const &s) { return determinant(s.n0); },
+                  [](Sample const &s) { return glm::determinant(s.gn0); });
+    ok &= compare("matrix4x4 determinant", inputs, 1e-5,
+                  [](Sample const &s) { return determinant(s.m0); },
+                  [](Sample const &s) { return glm::determinant(s.gm0); });
+    ok &= compare("matrix3x3 inverse", inputs, 1e-5,
+                  [](Sample const &s) { return inverse(s.n0); },
+                  [](Sample const &s) { return glm::inverse(s.gn0); });
+    ok &= compare("matrix4x4 inverse", inputs, 1e-5,
+                  [](Sample const &s) { return inverse(s.m0); },
+                  [](Sample const &s) { return glm::inverse(s.gm0); });
+    ok &= compare("rotate", inputs, 1e-5,
+                  [](Sample const &s) { return rotate(s.m1, s.angle, s.axis); },
+                  [](Sample const &s) { return glm::rotate(s.gm1, s.angle, s.gaxis); });
+    ok &= compare("lookAt", inputs, 1e-5,
+                  [](Sample const &s) { return matrix4x4<f32>::lookAt(s.u0, s.u1, s.axis); },
+                  [](Sample const &s) { return glm::lookAt(s.gu0, s.gu1, s.gaxis); });
+    ok &= compare("perspective", inputs, 1e-5,
+                  [](Sample const &s) { return matrix4x4<f32>::perspective(s.fov, s.aspect, s.zNear, s.zFar); },
+                  [](Sample const &s) { return glm::perspective(s.fov, s.aspect, s.zNear, s.zFar); });
+
+    ok &= compare("quaternion multiply", inputs, 1e-6,
+                  [](Sample const &s) { return s.q0 * s.q1; },
+                  [](Sample const &s) { return s.gq0 * s.gq1; });
+    ok &= compare("quaternion rotate vector3", inputs, 1e-5,
+                  [](Sample const &s) { return rotate(s.q0, s.u0); },
+                  [](Sample const &s) { return s.gq0 * s.gu0; });
+    ok &= compare("quaternion inverse", inputs, 1e-6,
+                  [](Sample const &s) { return inverse(s.q0); },
+                  [](Sample const &s) { return glm::inverse(s.gq0); });
+    ok &= compare("quaternion from_rotation", inputs, 1e-6,
+                  [](Sample const &s) { return quaternion<f32>::from_rotation(s.angle, s.axis); },
+                  [](Sample const &s) { return glm::angleAxis(s.angle, glm::normalize(s.gaxis)); });
+    ok &= compare("quaternion to matrix4x4", inputs, 1e-6,
+                  [](Sample const &s) { return matrix4x4<f32>::from_quaternion(s.q0); },
+                  [](Sample const &s) { return glm::mat4_cast(s.gq0); });
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
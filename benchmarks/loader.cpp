@@ -0,0 +1,248 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+// times obj::load (stream), obj::load_mapped (mapped), obj::load_parallel (parallel, and into the position-only and
+// packed vertex layouts) and repeat obj::load_cached loads (cached) on every model in the resources and on a synthetic textured grid, the per-corner time staying flat from the
+// smallest model to the largest is what shows the loader scales linearly, the peak column is how far one more load
+// raises the resident set above what it was before (linux only, elsewhere the column is left empty):
+//
+//   micro-obj-bench
+//   micro-obj-bench --faces 1000000 --directory resources/obj --json loader.json
+//
+// other options: --filter <substring>, --repetitions <n>, --warmup <n>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <micro-engine/core/types.h>
+#include <micro-engine/performance/suite.h>
+#include <micro-engine/utils/mesh-cache.h>
+#include <micro-engine/utils/object.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#ifndef RESOURCES_PATH
+#define RESOURCES_PATH "./resources/"
+#endif
+
+using namespace micro;
+using namespace micro::core;
+
+namespace {
+    struct Options {
+        perf::suite_options   suite{.warmup = 1, .repetitions = 5, .minRepetitionNs = 1'000'000.};
+        std::filesystem::path directory{RESOURCES_PATH "obj"};
+        usize                 faces = 1'000'000;
+        std::string           jsonPath{};
+    };
+
+    fn parse(int argc, char **argv) -> Options {
+        Options options{};
+        for (int i = 1; i < argc; ++i) {
+            auto const arg  = std::string{argv[i]};
+            auto const next = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+                    std::exit(EXIT_FAILURE);
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--json")
+                options.jsonPath = next();
+            else if (arg == "--directory")
+                options.directory = next();
+            else if (arg == "--faces")
+                options.faces = std::strtoull(next().c_str(), nullptr, 10);
+            else if (arg == "--filter")
+                options.suite.filter = next();
+            else if (arg == "--repetitions")
+                options.suite.repetitions = std::strtoull(next().c_str(), nullptr, 10);
+            else if (arg == "--warmup")
+                options.suite.warmup = std::strtoull(next().c_str(), nullptr, 10);
+            else {
+                std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+                std::exit(EXIT_FAILURE);
+            }
+        }
+        return options;
+    }
+
+    // a square grid of at least the given number of triangles, every grid point has its own position, uv and normal,
+    // so the loader sees the v/vt/vn corners of a textured mesh with every vertex shared by up to six triangles
+    fn writeGrid(std::filesystem::path const &path, usize faces) -> void {
+        usize cells = 1;
+        while (2 * cells * cells < faces)
+            ++cells;
+        auto const points = cells + 1;
+
+        std::ofstream os{path};
+        os << "# synthetic " << cells << "x" << cells << " textured grid\n";
+        for (usize y = 0; y < points; ++y)
+            for (usize x = 0; x < points; ++x)
+                os << "v " << static_cast<f32>(x) / static_cast<f32>(cells) << ' ' << static_cast<f32>(y) / static_cast<f32>(cells) << " 0\n";
+        for (usize y = 0; y < points; ++y)
+            for (usize x = 0; x < points; ++x)
+                os << "vt " << static_cast<f32>(x) / static_cast<f32>(cells) << ' ' << static_cast<f32>(y) / static_cast<f32>(cells) << '\n';
+        for (usize i = 0; i < points * points; ++i)
+            os << "vn 0 0 1\n";
+
+        auto const corner = [&](usize x, usize y) {
+            auto const index = std::to_string(y * points + x + 1);
+            return index + '/' + index + '/' + index;
+        };
+        for (usize y = 0; y < cells; ++y)
+            for (usize x = 0; x < cells; ++x) {
+                os << "f " << corner(x, y) << ' ' << corner(x + 1, y) << ' ' << corner(x + 1, y + 1) << '\n';
+                os << "f " << corner(x, y) << ' ' << corner(x + 1, y + 1) << ' ' << corner(x, y + 1) << '\n';
+            }
+    }
+
+    // kB from a "Name:   1234 kB" line of /proc/self/status, 0 when it is missing
+    fn statusKilobytes(cstring field) -> usize {
+        std::ifstream is{"/proc/self/status"};
+        std::string   line{};
+        while (std::getline(is, line))
+            if (line.starts_with(field))
+                return std::strtoull(line.c_str() + std::strlen(field), nullptr, 10);
+        return 0;
+    }
+
+    // bytes the resident set peaked above its starting size while running the given function once, the high-water
+    // mark is reset first by writing 5 to clear_refs and the free heap is handed back so earlier runs do not hide the
+    // growth, returns -1 where that is unavailable
+    template<typename F>
+    fn peakResident(F &&function) -> f64 {
+#if defined(__linux__)
+#if defined(__GLIBC__)
+        malloc_trim(0);
+#endif
+        if (std::ofstream os{"/proc/self/clear_refs"}; !(os << "5" << std::flush))
+            return -1.;
+
+        auto const before = statusKilobytes("VmRSS:");
+        function();
+        auto const peak = statusKilobytes("VmHWM:");
+        return peak > before ? static_cast<f64>(peak - before) * 1024. : 0.;
+#else
+        function();
+        return -1.;
+#endif
+    }
+
+    struct Model {
+        std::string name;
+        std::string path;
+        usize       vertices = 0;
+        usize       corners  = 0;
+    };
+}
+
+auto main(int argc, char **argv) -> int {
+    auto const options = parse(argc, argv);
+    auto const onError = [](std::string const &message) { std::fprintf(stderr, "%s\n", message.c_str()); };
+
+    std::vector<Model> models{};
+    std::error_code    error{};
+    for (auto const &entry : std::filesystem::directory_iterator{options.directory, error})
+        if (entry.is_regular_file() && entry.path().extension() == ".obj")
+            models.push_back(Model{entry.path().filename().string(), entry.path().string()});
+    if (error)
+        onError("unable to list " + options.directory.string() + ": " + error.message());
+
+    auto const grid = std::filesystem::temp_directory_path() / "micro-obj-bench-grid.obj";
+    if (options.faces > 0) {
+        writeGrid(grid, options.faces);
+        models.push_back(Model{"synthetic grid", grid.string()});
+    }
+
+    std::vector<graphics::Vertex> vertices{};
+    std::vector<u32>              indices{};
+    for (auto &model : models) {
+        vertices.clear();
+        indices.clear();
+        obj::load_mapped<u32>(model.path.c_str(), vertices, indices, onError);
+        model.vertices = vertices.size();
+        model.corners  = indices.size();
+    }
+    std::sort(models.begin(), models.end(), [](Model const &a, Model const &b) { return a.corners < b.corners; });
+
+    auto const cache = std::filesystem::temp_directory_path() / "micro-obj-bench-cache";
+
+    using Loader = std::function<void(cstring, std::vector<graphics::Vertex> &, std::vector<u32> &)>;
+    std::pair<cstring, Loader> const loaders[]{
+        {"stream", [&](auto path, auto &v, auto &i) { obj::load<u32>(path, v, i, onError); }},
+        {"mapped", [&](auto path, auto &v, auto &i) { obj::load_mapped<u32>(path, v, i, onError); }},
+        {"parallel", [&](auto path, auto &v, auto &i) { obj::load_parallel<u32>(path, v, i, onError); }},
+        // same parse into 12 and 16 instead of 52 bytes per vertex, the vertices are allocated on every run
+        {"position", [&](auto path, auto &, auto &i) {
+            std::vector<graphics::PositionVertex> v{};
+            obj::load_parallel<u32>(path, v, i, onError);
+            perf::do_not_optimize(v.data());
+        }},
+        {"packed", [&](auto path, auto &, auto &i) {
+            std::vector<graphics::PackedVertex> v{};
+            obj::load_parallel<u32>(path, v, i, onError);
+            perf::do_not_optimize(v.data());
+        }},
+        // the first, calibrating, run writes the cache every later one reads
+        {"cached", [&](auto path, auto &, auto &) { perf::do_not_optimize(obj::load_cached<u32>(path, cache, onError).indices().size()); }}
+    };
+
+    perf::suite suite{options.suite};
+    std::printf("%-32s %12s %12s %14s %14s %12s\n", "model", "corners", "vertices", "median ms", "ns per corner", "peak MiB");
+    for (auto const &model : models)
+        for (auto const &[mode, load] : loaders) {
+            auto const name     = model.name + " " + mode;
+            auto const measured = suite.results().size();
+            suite.run(name, [&](usize) {
+                vertices.clear();
+                indices.clear();
+                load(model.path.c_str(), vertices, indices);
+                return indices.size();
+            });
+            if (suite.results().size() == measured)
+                continue;
+
+            // measured after the timed runs so the cached mode reads the cache like every timed run did, the output
+            // vectors are released first so their growth counts towards the peak
+            std::vector<graphics::Vertex>{}.swap(vertices);
+            std::vector<u32>{}.swap(indices);
+            auto const peak = peakResident([&]() { load(model.path.c_str(), vertices, indices); });
+
+            char peakText[32]{};
+            if (peak >= 0.)
+                std::snprintf(peakText, sizeof(peakText), "%.2f", peak / (1024. * 1024.));
+
+            auto const median = suite.results().back().stats.median;
+            std::printf("%-32s %12zu %12zu %14.3f %14.2f %12s\n",
+                        name.c_str(), model.corners, model.vertices, median / 1.e6,
+                        median / static_cast<f64>(model.corners == 0 ? 1 : model.corners), peakText);
+        }
+
+    if (options.faces > 0)
+        std::filesystem::remove(grid, error);
+    std::filesystem::remove_all(cache, error);
+
+    if (!options.jsonPath.empty()) {
+        std::ofstream os{options.jsonPath};
+        if (!os) {
+            std::fprintf(stderr, "unable to write %s\n", options.jsonPath.c_str());
+            return EXIT_FAILURE;
+        }
+        suite.write_json(os);
+    }
+
+    return EXIT_SUCCESS;
+}
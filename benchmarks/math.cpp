@@ -0,0 +1,270 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+// microbenchmarks of the hot micro::math operations, results are printed as a table and optionally written as JSON,
+// a previous JSON run can be passed as the baseline to fail on per-operation regressions:
+//
+//   micro-math-bench --json baseline.json
+//   micro-math-bench --baseline baseline.json --tolerance 0.1 --tolerance-for "matrix4x4 inverse=0.25"
+//
+// other options: --filter <substring>, --repetitions <n>, --warmup <n>, --trace <path> adds a recorded trace (the
+// format perf::read_trace reads) as one more workload
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <numbers>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <micro-engine/mathematics.h>
+#include <micro-engine/performance/suite.h>
+#include <micro-engine/performance/workload.h>
+
+using namespace micro;
+using namespace micro::core;
+using namespace micro::math;
+
+namespace {
+    // inputs live on the heap and are cycled through by iteration index, so no operation sees constant operands
+    constexpr usize inputCount = 256;
+    constexpr usize inputMask  = inputCount - 1;
+
+    template<typename T, typename Generator>
+    fn inputs(Generator &&generate) -> std::vector<T> {
+        std::vector<T> res(inputCount);
+        for (auto &value : res)
+            value = generate();
+        return res;
+    }
+
+    struct Options {
+        perf::suite_options        suite{};
+        std::string                jsonPath{};
+        std::string                baselinePath{};
+        f64                        tolerance = .1;
+        std::map<std::string, f64> overrides{};
+        std::string                tracePath{};
+    };
+
+    fn parse(int argc, char **argv) -> Options {
+        Options options{};
+        for (int i = 1; i < argc; ++i) {
+            auto const arg  = std::string{argv[i]};
+            auto const next = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+                    std::exit(EXIT_FAILURE);
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--json")
+                options.jsonPath = next();
+            else if (arg == "--baseline")
+                options.baselinePath = next();
+            else if (arg == "--tolerance")
+                options.tolerance = std::strtod(next().c_str(), nullptr);
+            else if (arg == "--tolerance-for") {
+                auto const value = next();
+                auto const eq    = value.rfind('=');
+                if (eq == std::string::npos) {
+                    std::fprintf(stderr, "expected <name>=<tolerance>, got %s\n", value.c_str());
+                    std::exit(EXIT_FAILURE);
+                }
+                options.overrides[value.substr(0, eq)] = std::strtod(value.c_str() + eq + 1, nullptr);
+            }
+            else if (arg == "--filter")
+                options.suite.filter = next();
+            else if (arg == "--repetitions")
+                options.suite.repetitions = std::strtoull(next().c_str(), nullptr, 10);
+            else if (arg == "--warmup")
+                options.suite.warmup = std::strtoull(next().c_str(), nullptr, 10);
+            else if (arg == "--trace")
+                options.tracePath = next();
+            else {
+                std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+                std::exit(EXIT_FAILURE);
+            }
+        }
+        return options;
+    }
+}
+
+auto main(int argc, char **argv) -> int {
+    auto const options = parse(argc, argv);
+
+    std::mt19937                        engine{20261019};
+    std::uniform_real_distribution<f32> unit{-1.f, 1.f};
+
+    auto const v2 = inputs<vector2<f32>>([&]() { return vector2<f32>{unit(engine), unit(engine)}; });
+    auto const v3 = inputs<vector3<f32>>([&]() { return vector3<f32>{unit(engine), unit(engine), unit(engine)}; });
+    auto const v4 = inputs<vector4<f32>>([&]() { return vector4<f32>{unit(engine), unit(engine), unit(engine), unit(engine)}; });
+
+    auto const m2 = inputs<matrix2x2<f32>>([&]() { return matrix2x2<f32>{unit(engine), unit(engine), unit(engine), unit(engine)} + matrix2x2<f32>{4.f}; });
+    auto const m3 = inputs<matrix3x3<f32>>([&]() { return matrix3x3<f32>{v3[engine() & inputMask], v3[engine() & inputMask], v3[engine() & inputMask]} + matrix3x3<f32>{4.f}; });
+    auto const m4 = inputs<matrix4x4<f32>>([&]() { return matrix4x4<f32>{v4[engine() & inputMask], v4[engine() & inputMask], v4[engine() & inputMask], v4[engine() & inputMask]} + matrix4x4<f32>{4.f}; });
+
+    auto const angles = inputs<f32>([&]() { return unit(engine) * std::numbers::pi_v<f32>; });
+    auto const axes   = inputs<vector3<f32>>([&]() { return normalize(vector3<f32>{unit(engine), unit(engine), unit(engine) + 2.f}); });
+    auto const euler  = inputs<vector3<f32>>([&]() { return vector3<f32>{unit(engine), unit(engine), unit(engine)} * std::numbers::pi_v<f32>; });
+
+    auto const quats = inputs<quaternion<f32>>([&]() { return normalize(quaternion<f32>{unit(engine), unit(engine), unit(engine), unit(engine)}); });
+    auto const rots  = inputs<matrix3x3<f32>>([&]() { return matrix3x3<f32>::from_quaternion(quats[engine() & inputMask]); });
+    auto const affs  = inputs<affine3x4<f32>>([&]() { return affine3x4<f32>{rots[engine() & inputMask], v3[engine() & inputMask]}; });
+
+    perf::suite suite{options.suite};
+
+    // vectors, per size
+    suite.run("vector2 add", [&](usize i) { return v2[i & inputMask] + v2[(i + 1) & inputMask]; });
+    suite.run("vector3 add", [&](usize i) { return v3[i & inputMask] + v3[(i + 1) & inputMask]; });
+    suite.run("vector4 add", [&](usize i) { return v4[i & inputMask] + v4[(i + 1) & inputMask]; });
+    suite.run("vector2 scale", [&](usize i) { return v2[i & inputMask] * angles[i & inputMask]; });
+    suite.run("vector3 scale", [&](usize i) { return v3[i & inputMask] * angles[i & inputMask]; });
+    suite.run("vector4 scale", [&](usize i) { return v4[i & inputMask] * angles[i & inputMask]; });
+    suite.run("vector2 dot", [&](usize i) { return dot(v2[i & inputMask], v2[(i + 1) & inputMask]); });
+    suite.run("vector3 dot", [&](usize i) { return dot(v3[i & inputMask], v3[(i + 1) & inputMask]); });
+    suite.run("vector4 dot", [&](usize i) { return dot(v4[i & inputMask], v4[(i + 1) & inputMask]); });
+    suite.run("vector2 normalize", [&](usize i) { return normalize(v2[i & inputMask]); });
+    suite.run("vector3 normalize", [&](usize i) { return normalize(v3[i & inputMask]); });
+    suite.run("vector4 normalize", [&](usize i) { return normalize(v4[i & inputMask]); });
+    suite.run("vector3 cross", [&](usize i) { return cross(v3[i & inputMask], v3[(i + 1) & inputMask]); });
+
+    // matrices, per size
+    suite.run("matrix2x2 multiply", [&](usize i) { return m2[i & inputMask] * m2[(i + 1) & inputMask]; });
+    suite.run("matrix3x3 multiply", [&](usize i) { return m3[i & inputMask] * m3[(i + 1) & inputMask]; });
+    suite.run("matrix4x4 multiply", [&](usize i) { return m4[i & inputMask] * m4[(i + 1) & inputMask]; });
+    suite.run("matrix4x4 * vector4", [&](usize i) { return m4[i & inputMask] * v4[i & inputMask]; });
+    suite.run("matrix2x2 inverse", [&](usize i) { return inverse(m2[i & inputMask]); });
+    suite.run("matrix3x3 inverse", [&](usize i) { return inverse(m3[i & inputMask]); });
+    suite.run("matrix4x4 inverse", [&](usize i) { return inverse(m4[i & inputMask]); });
+    suite.run("matrix4x4 determinant", [&](usize i) { return determinant(m4[i & inputMask]); });
+    suite.run("matrix4x4 transpose", [&](usize i) { return transpose(m4[i & inputMask]); });
+
+    // quaternions
+    suite.run("quaternion multiply", [&](usize i) { return quats[i & inputMask] * quats[(i + 1) & inputMask]; });
+    suite.run("quaternion normalize", [&](usize i) { return normalize(quats[i & inputMask]); });
+    suite.run("quaternion rotate vector3", [&](usize i) { return rotate(quats[i & inputMask], v3[i & inputMask]); });
+
+    // euler angles
+    suite.run("matrix4x4 from_euler", [&](usize i) { auto const &e = euler[i & inputMask]; return matrix4x4<f32>::from_euler(e.x, e.y, e.z); });
+    suite.run("matrix3x3 from_euler<xyz>", [&](usize i) { return matrix3x3<f32>::from_euler<euler_order::xyz>(euler[i & inputMask]); });
+    suite.run("matrix3x3 from_euler<zxz>", [&](usize i) { return matrix3x3<f32>::from_euler<euler_order::zxz>(euler[i & inputMask]); });
+    suite.run("quaternion from_euler<xyz>", [&](usize i) { return quaternion<f32>::from_euler<euler_order::xyz>(euler[i & inputMask]); });
+    suite.run("vector3 from_euler<xyz>(matrix3x3)", [&](usize i) { return vector3<f32>::from_euler<euler_order::xyz>(rots[i & inputMask]); });
+
+    // rotation and transform composition
+    suite.run("matrix4x4 rotate", [&](usize i) { return rotate(m4[i & inputMask], angles[i & inputMask], axes[i & inputMask]); });
+    suite.run("affine3x4 rotate", [&](usize i) { return rotate(affs[i & inputMask], angles[i & inputMask], axes[i & inputMask]); });
+    suite.run("affine3x4 multiply", [&](usize i) { return affs[i & inputMask] * affs[(i + 1) & inputMask]; });
+    suite.run("compose_trs", [&](usize i) { return compose_trs(v3[i & inputMask], quats[i & inputMask], v3[(i + 1) & inputMask]); });
+
+    // conversions
+    suite.run("quaternion from_rotation", [&](usize i) { return quaternion<f32>::from_rotation(angles[i & inputMask], axes[i & inputMask]); });
+    suite.run("quaternion to matrix3x3", [&](usize i) { return matrix3x3<f32>::from_quaternion(quats[i & inputMask]); });
+    suite.run("quaternion to matrix4x4", [&](usize i) { return matrix4x4<f32>::from_quaternion(quats[i & inputMask]); });
+    suite.run("matrix3x3 to quaternion", [&](usize i) { return quaternion<f32>::from_matrix3x3(rots[i & inputMask]); });
+    suite.run("affine3x4 to quaternion", [&](usize i) { return affs[i & inputMask].to_quaternion(); });
+
+    // dispatched batch kernels, every variant the cpu supports, on one sequence of sequenceLength elements per call
+    constexpr usize sequenceLength = 4096;
+
+    std::vector<quaternion<f32>> sequenceQuats(sequenceLength);
+    std::vector<matrix3x3<f32>>  sequenceMats(sequenceLength);
+    soa_vector3<f32>             points{};
+    soa_vector3<f32>             transformed{};
+    for (usize i = 0; i < sequenceLength; ++i) {
+        sequenceQuats[i] = quats[i & inputMask];
+        sequenceMats[i]  = rots[i & inputMask];
+        points.push_back(v3[i & inputMask]);
+    }
+
+    for (auto const variant : kernel_variants) {
+        if (!supported(variant))
+            continue;
+
+        auto const suffix = std::string{" ["} + name(variant) + ']';
+        suite.run("compose quaternions" + suffix, [&](usize) { return compose(sequenceQuats.data(), sequenceLength, variant); });
+        suite.run("compose matrix3x3" + suffix, [&](usize) { return compose(sequenceMats.data(), sequenceLength, variant); });
+        suite.run("soa_vector3 bounds" + suffix, [&](usize) { return bounds(points, variant); });
+        suite.run("soa_vector3 transform" + suffix, [&](usize i) { transform(points, m4[i & inputMask], transformed, variant); });
+        suite.run("soa_vector3 transform matrix3x3" + suffix, [&](usize i) { transform(points, rots[i & inputMask], transformed, variant); });
+        suite.run("soa_vector3 sandwich" + suffix, [&](usize i) { sandwich(points, quats[i & inputMask], transformed, variant); });
+    }
+
+    // structured workloads, the same operations on inputs that take their rarely exercised branches
+    std::vector<perf::rotation_sample> trace{};
+    if (!options.tracePath.empty()) {
+        std::ifstream is{options.tracePath};
+        if (!is) {
+            std::fprintf(stderr, "unable to read %s\n", options.tracePath.c_str());
+            return EXIT_FAILURE;
+        }
+        trace = perf::read_trace(is, [](std::string const &message) { std::fprintf(stderr, "%s\n", message.c_str()); });
+    }
+
+    for (auto const kind : perf::workloads) {
+        if (kind == perf::workload::trace && trace.empty())
+            continue;
+
+        auto generator = kind == perf::workload::trace ? perf::workload_generator{trace} : perf::workload_generator{kind};
+        auto samples   = generator.take(sequenceLength);
+
+        std::vector<quaternion<f32>> sampleQuats(sequenceLength);
+        std::vector<matrix3x3<f32>>  sampleMats(sequenceLength);
+        std::vector<vector3<f32>>    from(sequenceLength);
+        std::vector<vector3<f32>>    to(sequenceLength);
+        for (usize i = 0; i < sequenceLength; ++i) {
+            sampleQuats[i] = samples[i].to_quaternion();
+            sampleMats[i]  = matrix3x3<f32>::from_quaternion(sampleQuats[i]);
+            // perpendicular to the axis, so near pi the pair is close to antiparallel
+            from[i] = normalize(cross(normalize(samples[i].axis), v3[i & inputMask] + vector3<f32>{0.f, 0.f, 4.f}));
+            to[i]   = rotate(sampleQuats[i], from[i]);
+        }
+
+        auto const prefix = std::string{perf::name(kind)} + ": ";
+        suite.run(prefix + "quaternion from_rotation", [&](usize i) { return quaternion<f32>::from_rotation(samples[i & inputMask].angle, samples[i & inputMask].axis); });
+        suite.run(prefix + "vector3 normalize axis", [&](usize i) { return normalize(samples[i & inputMask].axis); });
+        suite.run(prefix + "matrix3x3 to quaternion", [&](usize i) { return quaternion<f32>::from_matrix3x3(sampleMats[i & inputMask]); });
+        suite.run(prefix + "quaternion from two vectors", [&](usize i) { return quaternion<f32>{from[i & inputMask], to[i & inputMask]}; });
+        suite.run(prefix + "matrix3x3 from_euler<xyz>", [&](usize i) { return matrix3x3<f32>::from_euler<euler_order::xyz>(samples[i & inputMask].euler); });
+        suite.run(prefix + "compose quaternions", [&](usize) { return compose(sampleQuats.data(), sequenceLength); });
+        suite.run(prefix + "compose matrix3x3", [&](usize) { return compose(sampleMats.data(), sequenceLength); });
+    }
+
+    suite.print();
+
+    if (!options.jsonPath.empty()) {
+        std::ofstream os{options.jsonPath};
+        if (!os) {
+            std::fprintf(stderr, "unable to write %s\n", options.jsonPath.c_str());
+            return EXIT_FAILURE;
+        }
+        suite.write_json(os);
+    }
+
+    if (options.baselinePath.empty())
+        return EXIT_SUCCESS;
+
+    std::ifstream is{options.baselinePath};
+    if (!is) {
+        std::fprintf(stderr, "unable to read %s\n", options.baselinePath.c_str());
+        return EXIT_FAILURE;
+    }
+
+    usize regressions = 0;
+    std::printf("\n%-36s %12s %12s %8s %10s\n", "against baseline", "baseline ns", "current ns", "ratio", "tolerance");
+    for (auto const &comparison : suite.compare(perf::suite::read_json(is), options.tolerance, options.overrides)) {
+        std::printf("%-36s %12.2f %12.2f %8.3f %9.0f%%  %s\n",
+                    comparison.name.c_str(), comparison.baseline, comparison.current, comparison.ratio(),
+                    100. * comparison.tolerance, comparison.regressed() ? "REGRESSED" : "ok");
+        regressions += comparison.regressed();
+    }
+    std::printf("\n%zu regression(s)\n", regressions);
+
+    return regressions == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,141 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+// builds the lod chain of every model in the resources and reports the triangles, surface area and build time of every
+// level, on the convex models every level has to stay a closed outward facing surface, exits with a failure if a level
+// of one of them holds a triangle facing its center against the winding of the full model, two triangles over the same
+// corners, or more area than the full model:
+//
+//   micro-obj-lod
+//   micro-obj-lod --directory resources/obj
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <micro-engine/core/types.h>
+#include <micro-engine/graphics/vertex.h>
+#include <micro-engine/utils/mesh-simplify.h>
+#include <micro-engine/utils/object.h>
+
+#ifndef RESOURCES_PATH
+#define RESOURCES_PATH "./resources/"
+#endif
+
+using namespace micro;
+using namespace micro::core;
+
+namespace {
+    // closed convex surfaces, a correct simplification of one never faces inwards or grows
+    constexpr std::array<cstring, 4> convex{"cube.obj", "simple_cube.obj", "cylinder.obj", "sphere.obj"};
+
+    // allowance for the rounding of the area sums
+    constexpr f64 area_tolerance = 1.e-4;
+
+    struct Level {
+        usize triangles = 0;
+        f64   area      = 0.;
+        usize inward    = 0;
+        usize repeated  = 0;
+    };
+
+    // inward is measured against the mean of the level's own vertices, which lies inside any convex surface, and the
+    // winding, +1 for counter-clockwise outside, the full model was written with
+    fn inspect(std::vector<graphics::PositionVertex> const &vertices, std::span<u32 const> indices, f32 winding) -> Level {
+        std::set<u32>      used(indices.begin(), indices.end());
+        math::vector3<f32> center{0.f};
+        for (auto const v : used)
+            center = center + vertices[v].position;
+        center = center / static_cast<f32>(std::max<usize>(used.size(), 1));
+
+        Level                        res{indices.size() / 3};
+        std::set<std::array<u32, 3>> corners{};
+        for (usize first = 0; first + 2 < indices.size(); first += 3) {
+            auto const a = vertices[indices[first]].position, b = vertices[indices[first + 1]].position, c = vertices[indices[first + 2]].position;
+            auto const n = math::cross(b - a, c - a);
+            res.area += static_cast<f64>(math::magnitude(n)) / 2.;
+
+            auto const centroid = (a + b + c) / 3.f;
+            if (winding * math::dot(n, centroid - center) <= 0.f)
+                ++res.inward;
+
+            std::array<u32, 3> key{indices[first], indices[first + 1], indices[first + 2]};
+            std::sort(key.begin(), key.end());
+            if (!corners.insert(key).second)
+                ++res.repeated;
+        }
+        return res;
+    }
+}
+
+auto main(int argc, char **argv) -> int {
+    std::filesystem::path directory{RESOURCES_PATH "obj"};
+    for (int i = 1; i < argc; ++i) {
+        if (std::string{argv[i]} == "--directory" && i + 1 < argc)
+            directory = argv[++i];
+        else {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<std::filesystem::path> paths{};
+    std::error_code                    error{};
+    for (auto const &entry : std::filesystem::directory_iterator{directory, error})
+        if (entry.is_regular_file() && entry.path().extension() == ".obj")
+            paths.push_back(entry.path());
+    if (error) {
+        std::fprintf(stderr, "unable to list %s: %s\n", directory.string().c_str(), error.message().c_str());
+        return EXIT_FAILURE;
+    }
+    std::sort(paths.begin(), paths.end());
+
+    auto ok = true;
+    std::printf("%-24s %10s %6s %12s %10s %8s %8s %10s\n", "model", "triangles", "level", "triangles", "area", "inward", "repeated", "build ms");
+    for (auto const &path : paths) {
+        std::vector<graphics::PositionVertex> vertices{};
+        std::vector<u32>                      indices{};
+        obj::load_parallel<u32>(path.string().c_str(), vertices, indices, [](auto const &message) { std::fprintf(stderr, "%s\n", message.c_str()); });
+
+        auto const start  = std::chrono::steady_clock::now();
+        auto const levels = obj::build_lod_chain(std::span<graphics::PositionVertex const>{vertices}, indices);
+        auto const ms     = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        auto const name   = path.filename().string();
+        auto const strict = std::find(convex.begin(), convex.end(), name) != convex.end();
+
+        // six times the enclosed volume, negative when the outside is wound clockwise
+        f32 volume = 0.f;
+        for (usize first = 0; first < levels.front().count; first += 3)
+            volume += math::dot(vertices[indices[first]].position,
+                                math::cross(vertices[indices[first + 1]].position, vertices[indices[first + 2]].position));
+        auto const winding = volume < 0.f ? -1.f : 1.f;
+
+        f64 full = 0.;
+        for (usize level = 0; level < levels.size(); ++level) {
+            auto const result = inspect(vertices, std::span<u32 const>{indices}.subspan(levels[level].first, levels[level].count), winding);
+            if (level == 0)
+                full = result.area;
+
+            auto const failed = strict && (result.inward > 0 || result.repeated > 0 || result.area > full * (1. + area_tolerance));
+            ok                = ok && !failed;
+
+            char buildText[32]{};
+            if (level == 0)
+                std::snprintf(buildText, sizeof(buildText), "%.2f", ms);
+
+            std::printf("%-24s %10zu %6zu %12zu %10.4g %8zu %8zu %10s%s\n",
+                        level == 0 ? name.c_str() : "", levels.front().count / 3, level, result.triangles, result.area,
+                        result.inward, result.repeated, buildText, failed ? "  FAILED" : "");
+        }
+    }
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,156 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+#ifndef FINAL_COMPARISON_H
+#define FINAL_COMPARISON_H
+
+#include <array>
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "micro-engine/micro.h"
+
+#include "rotation.h"
+
+using namespace micro;
+using namespace micro::core;
+using namespace micro::math;
+
+struct ComparisonMetric {
+    RotationMode                  mode;
+    usize                         rotations;
+    std::chrono::nanoseconds::rep time;
+    f32                           maxAngularDifference;
+    kernel_variant                kernel;
+
+    friend fn operator<<(std::ostream &os, ComparisonMetric const &cm) -> std::ostream &;
+};
+
+fn operator<<(std::ostream &os, ComparisonMetric const &cm) -> std::ostream & { return os << toString(cm.mode) << ',' << cm.rotations << ',' << cm.time << ',' << cm.maxAngularDifference << ',' << name(cm.kernel) << '\n'; }
+
+static constexpr std::array<RotationMode, 3> comparisonModes{
+    RotationMode::Euler,
+    RotationMode::Matrix,
+    RotationMode::Quaternion
+};
+
+auto angularDifference(quaternion<f32> const &q1, quaternion<f32> const &q2) -> f32 {
+    return 2.f * math::acos(math::clamp(math::abs(dot(normalize(q1), normalize(q2))), 0.f, 1.f));
+}
+
+// composes the whole sequence with the same dispatched kernel pipeline() uses for the given mode and returns the
+// resulting orientation, Matrix mode post-multiplies in pipeline(), so its sequence is laid out in the kernel's
+// first-applied-first order here to end up with the same product as the other two modes
+auto composeSequence(RotationMode                   mode,
+                     std::vector<Rotation> const &  rotations,
+                     std::chrono::nanoseconds::rep &time) -> quaternion<f32> {
+    switch (mode) {
+        default:
+        case RotationMode::Euler: {
+            std::vector<matrix3x3<f32>> mats(rotations.size());
+            auto                        rotationsAcc = matrix3x3<f32>::identity();
+            time = perf::benchmark<std::chrono::high_resolution_clock, std::chrono::nanoseconds>(
+                [&]() {
+                    with_euler_order(
+                        rotations.empty() ? euler_order::xyz : rotations.front().order,
+                        [&](auto o) {
+                            std::transform(
+                                rotations.begin(), rotations.end(),
+                                mats.begin(),
+                                [](Rotation const &p) { return matrix3x3<f32>::from_euler<decltype(o)::value>(p.compound); }
+                            );
+                        }
+                    );
+                    rotationsAcc = compose(mats.data(), mats.size());
+                }
+            );
+            return quaternion<f32>{rotationsAcc};
+        }
+        case RotationMode::Matrix: {
+            std::vector<matrix3x3<f32>> mats(rotations.size());
+            auto                        rotationsAcc = matrix3x3<f32>::identity();
+            time = perf::benchmark<std::chrono::high_resolution_clock, std::chrono::nanoseconds>(
+                [&]() {
+                    std::transform(
+                        rotations.begin(), rotations.end(),
+                        mats.begin(),
+                        [](Rotation const &p) { return affine3x4<f32>::from_rotation(p.simple.angle, p.simple.axis).rotation(); }
+                    );
+                    rotationsAcc = compose(mats.data(), mats.size());
+                }
+            );
+            return quaternion<f32>{rotationsAcc};
+        }
+        case RotationMode::Quaternion: {
+            std::vector<quaternion<f32>> quats(rotations.size());
+            auto                         rotationsAcc = quaternion<f32>::real(1.f);
+            time = perf::benchmark<std::chrono::high_resolution_clock, std::chrono::nanoseconds>(
+                [&]() {
+                    std::transform(
+                        rotations.begin(), rotations.end(),
+                        quats.begin(),
+                        [](Rotation const &p) { return quaternion<f32>::from_rotation(p.simple.angle, p.simple.axis); }
+                    );
+                    rotationsAcc = compose(quats.data(), quats.size());
+                }
+            );
+            return rotationsAcc;
+        }
+    }
+}
+
+// converts one sequence to every mode's representation and composes all modes concurrently, each on its own pinned thread
+auto compare(std::vector<Rotation> const &sequence) -> std::vector<ComparisonMetric> {
+    std::array<quaternion<f32>, comparisonModes.size()>               orientations{};
+    std::array<std::chrono::nanoseconds::rep, comparisonModes.size()> times{};
+
+    std::vector<std::thread> workers{};
+    workers.reserve(comparisonModes.size());
+    for (usize i = 0; i < comparisonModes.size(); ++i) {
+        workers.emplace_back(
+            [&, i]() {
+                // keep the first cpu free for the render thread
+                perf::pin(i + 1);
+
+                std::vector<Rotation> rotations{};
+                rotations.reserve(sequence.size());
+                std::transform(
+                    sequence.begin(), sequence.end(),
+                    std::back_inserter(rotations),
+                    [&](Rotation const &rotation) { return rotation.to(comparisonModes[i]); }
+                );
+
+                orientations[i] = composeSequence(comparisonModes[i], rotations, times[i]);
+            }
+        );
+    }
+    for (auto &worker : workers)
+        worker.join();
+
+    std::vector<ComparisonMetric> metrics{};
+    metrics.reserve(comparisonModes.size());
+    for (usize i = 0; i < comparisonModes.size(); ++i) {
+        auto maxAngularDifference = 0.f;
+        for (usize j = 0; j < comparisonModes.size(); ++j)
+            if (i != j)
+                maxAngularDifference = math::max(maxAngularDifference,
+                                                 angularDifference(orientations[i], orientations[j]));
+
+        metrics.emplace_back(
+            ComparisonMetric{
+                comparisonModes[i],
+                sequence.size(),
+                times[i],
+                maxAngularDifference,
+                kernels()[comparisonModes[i] == RotationMode::Quaternion ? kernel::compose_quaternion : kernel::compose_matrix]
+            }
+        );
+    }
+
+    return metrics;
+}
+
+#endif //FINAL_COMPARISON_H
@@ -16,6 +16,11 @@ namespace Application {
         static constexpr i32     Height = 600;
     }
 
+    namespace Cache {
+        // parsed models are kept here, under the temporary directory, between runs
+        static constexpr cstring Directory = "rotation-mesh-cache";
+    }
+
     namespace Shaders {
         namespace Vertex {
             namespace Attributes {
@@ -26,35 +31,71 @@ namespace Application {
             }
 
             namespace Uniforms {
-                static constexpr cstring Model      = "u_model";
-                static constexpr cstring View       = "u_view";
-                static constexpr cstring Projection = "u_projection";
-                static constexpr cstring Color      = "u_color";
+                static constexpr cstring Model          = "u_model";
+                static constexpr cstring ViewProjection = "u_view_projection";
+                static constexpr cstring Color          = "u_color";
+                static constexpr cstring Rotation       = "u_rotation";
+                static constexpr cstring Translation    = "u_translation";
+                static constexpr cstring Scale          = "u_scale";
+                static constexpr cstring Pivot          = "u_pivot";
             }
 
             static constexpr cstring Model = R"(
                 #version 330 core
-                uniform mat4 u_model;
-                uniform mat4 u_view;
-                uniform mat4 u_projection;
+                uniform mat4x3 u_model;
+                uniform mat4 u_view_projection;
+
+                in vec3 a_position;
+
+                void main(void) {
+                    gl_Position = u_view_projection * vec4(u_model * vec4(a_position, 1.0f), 1.0f);
+                }
+            )";
+
+            // T * R * S * C without a model matrix, the rotation is a unit quaternion (xyz vector part, w scalar)
+            // applied as v + w * t + q.xyz x t with t = 2 * q.xyz x v
+            static constexpr cstring ModelQuaternion = R"(
+                #version 330 core
+                uniform vec4 u_rotation;
+                uniform vec3 u_translation;
+                uniform vec3 u_scale;
+                uniform vec3 u_pivot;
+                uniform mat4 u_view_projection;
 
                 in vec3 a_position;
 
+                vec3 rotate(vec4 q, vec3 v) {
+                    vec3 t = 2.0f * cross(q.xyz, v);
+                    return v + q.w * t + cross(q.xyz, t);
+                }
+
                 void main(void) {
-                    gl_Position = u_projection * u_view * u_model * vec4(a_position, 1.0f);
+                    vec3 world = u_translation + rotate(u_rotation, u_scale * (a_position - u_pivot));
+                    gl_Position = u_view_projection * vec4(world, 1.0f);
                 }
             )";
 
             static constexpr cstring BoundingBox = R"(
                 #version 330 core
-                uniform mat4 u_model;
-                uniform mat4 u_view;
-                uniform mat4 u_projection;
+                uniform mat4x3 u_model;
+                uniform mat4 u_view_projection;
+
+                in vec3 a_position;
+
+                void main(void) {
+                    gl_Position = u_view_projection * vec4(u_model * vec4(a_position, 1.0f), 1.0f);
+                }
+            )";
+
+            // the trajectory is already in world space
+            static constexpr cstring Trajectory = R"(
+                #version 330 core
+                uniform mat4 u_view_projection;
 
                 in vec3 a_position;
 
                 void main(void) {
-                    gl_Position = u_projection * u_view * u_model * vec4(a_position, 1.0f);
+                    gl_Position = u_view_projection * vec4(a_position, 1.0f);
                 }
             )";
         }
@@ -81,6 +122,16 @@ namespace Application {
                     FragColor = vec4(1.0f, 0.0f, 0.0f, 1.0f);
                 }
             )";
+
+            static constexpr cstring Trajectory = R"(
+                #version 330 core
+
+                out vec4 FragColor;
+
+                void main(void) {
+                    FragColor = vec4(1.0f, 1.0f, 0.0f, 1.0f);
+                }
+            )";
         }
     }
 }
@@ -6,11 +6,14 @@
 #define FINAL_INTERFACE_H
 
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <numbers>
 #include <string>
 
 #include "micro-engine/micro.h"
 
+#include "comparison.h"
 #include "metrics.h"
 #include "rotation.h"
 #include "state.h"
@@ -22,6 +25,8 @@ using namespace micro::context;
 auto interface(State &state) -> void {
     auto const currentTime = ImGui::GetTime();
 
+    pollModelLoad(state);
+
     if (state.ui.benchmark.automated.enable) {
         if ((state.ui.benchmark.automated.forceRotationsCount &&
              state.ui.benchmark.automated.generatedRotationsCount == state.ui.benchmark.automated.rotationsCount) ||
@@ -55,38 +60,9 @@ auto interface(State &state) -> void {
                 state.ui.benchmark.automated.elapsedTime = currentTime;
                 state.ui.benchmark.automated.generatedRotationsCount++;
 
-                if (state.ui.rotation.current.mode == RotationMode::Euler) {
-                    state.ui.rotation.current.compound = vector3<f32>{
-                        state.random.distribution(state.random.engine) * 2 * std::numbers::pi_v<f32>,
-                        state.random.distribution(state.random.engine) * 2 * std::numbers::pi_v<f32>,
-                        state.random.distribution(state.random.engine) * 2 * std::numbers::pi_v<f32>
-                    };
-                    state.ui.rotation.modeRotations[state.ui.rotation.current.mode].emplace_back(
-                        state.ui.rotation.current);
-
-                    state.ui.rotation.current.compound = vector3<f32>{0.f};
-
-                    state.ui.rotation.modeRotationIndex =
-                        state.ui.rotation.modeRotations[state.ui.rotation.current.mode].size() - 1;
-                }
-                else {
-                    state.ui.rotation.current.simple.angle =
-                        state.random.distribution(state.random.engine) * 2 * std::numbers::pi_v<f32>;
-                    state.ui.rotation.current.simple.axis = vector3<f32>{
-                        state.random.distribution(state.random.engine),
-                        state.random.distribution(state.random.engine),
-                        state.random.distribution(
-                            state.random.engine)
-                    };
-                    state.ui.rotation.modeRotations[state.ui.rotation.current.mode].emplace_back(
-                        state.ui.rotation.current);
-
-                    state.ui.rotation.current.simple.angle = 0.f;
-                    state.ui.rotation.current.simple.axis  = vector3<f32>{0.f};
-
-                    state.ui.rotation.modeRotationIndex =
-                        state.ui.rotation.modeRotations[state.ui.rotation.current.mode].size() - 1;
-                }
+                addRotation(state, fromSample(state.ui.benchmark.automated.generator.next(),
+                                              state.ui.rotation.current.mode,
+                                              state.ui.rotation.eulerOrder));
             }
         }
     }
@@ -95,9 +71,12 @@ auto interface(State &state) -> void {
         state.ui.benchmark.metrics.emplace_back(
             BenchmarkMetric{
                 state.model.vertices.size,
-                state.model.indices.size,
+                state.model.indexCount(),
                 state.ui.rotation.modeRotations[state.ui.rotation.current.mode].size(),
-                state.ui.rotation.timeNs
+                state.ui.rotation.timeNs,
+                state.ui.rotation.kernelVariant,
+                state.ui.benchmark.transform.representation,
+                state.ui.benchmark.transform.representation != VertexTransform::None ? state.ui.benchmark.transform.timeNs : 0
             }
         );
         state.ui.benchmark.standard.framesSinceStartup++;
@@ -111,6 +90,38 @@ auto interface(State &state) -> void {
                               1 / view.deltaTime, view.deltaTime * 1000.f);
             ImGui::BulletText("time since startup: %.2f s", currentTime);
             ImGui::BulletText("frame count since startup: %zu", ++state.ui.program.framesSinceStartup);
+
+            ImGui::SeparatorText("Kernels");
+
+            ImGui::BulletText("cpu: %s (%zu hardware threads)", perf::cpu().toString().c_str(), perf::concurrency());
+            for (auto const k : kernels_all)
+                ImGui::BulletText("%s: %s", name(k), name(kernels()[k]));
+
+            // times every supported variant on the current sequence length and keeps the fastest one per kernel
+            auto const length = state.ui.rotation.modeRotations[state.ui.rotation.current.mode].size() + 1;
+            ImGui::BeginDisabled(state.ui.benchmark.standard.enable || state.ui.benchmark.automated.enable);
+            if (ImGui::Button("Autotune"))
+                state.ui.program.autotune = autotune(length);
+            ImGui::EndDisabled();
+            ImGui::SameLine();
+            ImGui::Text("for %zu rotations", length);
+
+            if (state.ui.program.autotune.length > 0) {
+                ImGui::Text("last autotune on %zu elements, ns per call:", state.ui.program.autotune.length);
+                for (auto const k : kernels_all) {
+                    std::string timings{};
+                    for (auto const variant : kernel_variants) {
+                        auto const ns = state.ui.program.autotune.ns[static_cast<usize>(k)][static_cast<usize>(variant)];
+                        if (ns <= 0.)
+                            continue;
+
+                        char buffer[48];
+                        std::snprintf(buffer, sizeof(buffer), "%s%s %.0f", timings.empty() ? "" : ", ", name(variant), ns);
+                        timings += buffer;
+                    }
+                    ImGui::BulletText("%s: %s", name(k), timings.c_str());
+                }
+            }
         }
 
         if (ImGui::CollapsingHeader("Benchmark")) {
@@ -170,7 +181,7 @@ auto interface(State &state) -> void {
 
                     std::ofstream os{filename};
 
-                    os << "Vertices,Indices,Rotations,Time(ns)\n";
+                    os << "Vertices,Indices,Rotations,Time(ns),Kernel,Transform,TransformTime(ns)\n";
                     std::copy(state.ui.benchmark.metrics.begin(),
                               state.ui.benchmark.metrics.end(),
                               std::ostream_iterator<BenchmarkMetric>(os)
@@ -188,6 +199,39 @@ auto interface(State &state) -> void {
             ImGui::InputScalar("Number of rotations", ImGuiDataType_U32, &state.ui.benchmark.automated.rotationsCount);
             ImGui::InputScalar("Number of seconds", ImGuiDataType_U32, &state.ui.benchmark.automated.secondsCount);
             ImGui::Checkbox("Force exact number of rotations", &state.ui.benchmark.automated.forceRotationsCount);
+
+            if (ImGui::BeginCombo("Workload", perf::name(state.ui.benchmark.automated.workload))) {
+                for (auto const kind : perf::workloads)
+                    if (ImGui::Selectable(perf::name(kind), kind == state.ui.benchmark.automated.workload))
+                        state.ui.benchmark.automated.workload = kind;
+                ImGui::EndCombo();
+            }
+
+            if (state.ui.benchmark.automated.workload == perf::workload::trace) {
+                if (ImGui::Button("Load trace"))
+                    ImGuiFileDialog::Instance()->OpenDialog("ChooseTraceDlgKey", "Choose File", ".csv,.txt",
+                                                            state.ui.benchmark.automated.tracePath);
+                ImGui::SameLine();
+                ImGui::Text("%zu recorded rotations", state.ui.benchmark.automated.trace.size());
+
+                if (ImGuiFileDialog::Instance()->Display("ChooseTraceDlgKey")) {
+                    if (ImGuiFileDialog::Instance()->IsOk()) {
+                        state.ui.benchmark.automated.tracePath = ImGuiFileDialog::Instance()->GetFilePathName();
+
+                        // the samples keep their own order, the replay re-expresses them in the current one
+                        std::ifstream is{state.ui.benchmark.automated.tracePath};
+                        if (!is)
+                            cerror << "Unable to open " << state.ui.benchmark.automated.tracePath << std::endl;
+                        else
+                            state.ui.benchmark.automated.trace = perf::read_trace(
+                                is,
+                                [](auto const &msg) { cwarn << msg << std::endl; }
+                            );
+                    }
+
+                    ImGuiFileDialog::Instance()->Close();
+                }
+            }
             ImGui::EndDisabled();
 
             ImGui::BulletText(
@@ -200,11 +244,22 @@ auto interface(State &state) -> void {
                 state.ui.benchmark.automated.rotationsCount
             );
 
-            ImGui::BeginDisabled(state.ui.benchmark.standard.enable || state.ui.benchmark.automated.enable);
+            ImGui::BeginDisabled(state.ui.benchmark.standard.enable || state.ui.benchmark.automated.enable ||
+                                 (state.ui.benchmark.automated.workload == perf::workload::trace &&
+                                  state.ui.benchmark.automated.trace.empty()));
             if (ImGui::Button("Start##1")) {
                 state.ui.benchmark.standard.enable  = true;
                 state.ui.benchmark.automated.enable = true;
 
+                auto const options = perf::workload_options{
+                    .seed = static_cast<u32>(std::chrono::system_clock::now().time_since_epoch().count()),
+                    .order = state.ui.rotation.eulerOrder
+                };
+                state.ui.benchmark.automated.generator =
+                    state.ui.benchmark.automated.workload == perf::workload::trace
+                        ? perf::workload_generator{state.ui.benchmark.automated.trace, options}
+                        : perf::workload_generator{state.ui.benchmark.automated.workload, options};
+
                 state.ui.benchmark.automated.generatedRotationsCount = 0;
 
                 state.ui.benchmark.automated.endTime = currentTime + state.ui.benchmark.automated.secondsCount;
@@ -218,6 +273,106 @@ auto interface(State &state) -> void {
             }
             ImGui::EndDisabled();
 
+            ImGui::SeparatorText("Comparison");
+
+            ImGui::BulletText("composes the current %s sequence (%zu rotations) in every mode on identical input",
+                              toString(state.ui.rotation.current.mode).c_str(),
+                              state.ui.rotation.modeRotations[state.ui.rotation.current.mode].size());
+
+            ImGui::BeginDisabled(state.ui.benchmark.standard.enable || state.ui.benchmark.automated.enable ||
+                                 state.ui.rotation.modeRotations[state.ui.rotation.current.mode].empty());
+            if (ImGui::Button("Compare"))
+                state.ui.benchmark.comparison.metrics =
+                    compare(state.ui.rotation.modeRotations[state.ui.rotation.current.mode]);
+            ImGui::EndDisabled();
+            ImGui::SameLine();
+
+            ImGui::BeginDisabled(state.ui.benchmark.comparison.metrics.empty());
+            if (ImGui::Button("Save##2")) {
+                auto filters = "CSV file (*.csv){.csv}";
+                ImGuiFileDialog::Instance()->OpenDialog("SaveComparisonDlgKey", "Choose a File", filters, ".");
+            }
+
+            if (ImGuiFileDialog::Instance()->Display("SaveComparisonDlgKey")) {
+                if (ImGuiFileDialog::Instance()->IsOk()) {
+                    std::string filename = ImGuiFileDialog::Instance()->GetFilePathName();
+
+                    std::ofstream os{filename};
+
+                    os << "Mode,Rotations,Time(ns),MaxAngularDifference(rad),Kernel\n";
+                    std::copy(state.ui.benchmark.comparison.metrics.begin(),
+                              state.ui.benchmark.comparison.metrics.end(),
+                              std::ostream_iterator<ComparisonMetric>(os)
+                    );
+                }
+
+                ImGuiFileDialog::Instance()->Close();
+            }
+            ImGui::EndDisabled();
+
+            for (auto const &metric : state.ui.benchmark.comparison.metrics)
+                ImGui::BulletText("%s: %zu rotations in %lld ns (%.2f us), max angular difference %.3e rad (%s kernel)",
+                                  toString(metric.mode).c_str(), metric.rotations,
+                                  static_cast<long long>(metric.time), static_cast<f64>(metric.time) / 1000.,
+                                  metric.maxAngularDifference, name(metric.kernel));
+
+            ImGui::SeparatorText("Vertex transform");
+
+            ImGui::BulletText("rotates every position of the model on the cpu each frame, timed into the benchmark metrics");
+
+            if (ImGui::BeginCombo("Representation", toString(state.ui.benchmark.transform.representation).c_str())) {
+                for (auto const representation : {VertexTransform::None, VertexTransform::Quaternion,
+                                                  VertexTransform::Matrix3x3, VertexTransform::Matrix4x4})
+                    if (ImGui::Selectable(toString(representation).c_str(),
+                                          representation == state.ui.benchmark.transform.representation))
+                        state.ui.benchmark.transform.representation = representation;
+                ImGui::EndCombo();
+            }
+
+            if (state.ui.benchmark.transform.representation != VertexTransform::None)
+                ImGui::BulletText("%zu vertices in %lld ns (%.3f ns per vertex)",
+                                  state.model.positions.size(),
+                                  static_cast<long long>(state.ui.benchmark.transform.timeNs),
+                                  static_cast<f64>(state.ui.benchmark.transform.timeNs) /
+                                  static_cast<f64>(state.model.positions.empty() ? 1 : state.model.positions.size()));
+
+            ImGui::BeginDisabled(state.ui.benchmark.standard.enable || state.ui.benchmark.automated.enable);
+            if (ImGui::Button("Run on all models"))
+                state.ui.benchmark.transform.metrics = benchmarkTransforms(
+                    RESOURCES_PATH "obj/",
+                    [](auto const &msg) { cwarn << msg << std::endl; }
+                );
+            ImGui::EndDisabled();
+            ImGui::SameLine();
+
+            ImGui::BeginDisabled(state.ui.benchmark.transform.metrics.empty());
+            if (ImGui::Button("Save##3")) {
+                auto filters = "CSV file (*.csv){.csv}";
+                ImGuiFileDialog::Instance()->OpenDialog("SaveTransformDlgKey", "Choose a File", filters, ".");
+            }
+
+            if (ImGuiFileDialog::Instance()->Display("SaveTransformDlgKey")) {
+                if (ImGuiFileDialog::Instance()->IsOk()) {
+                    std::string filename = ImGuiFileDialog::Instance()->GetFilePathName();
+
+                    std::ofstream os{filename};
+
+                    os << "Model,Vertices,Transform,Kernel,Median(ns),Min(ns),PerVertex(ns)\n";
+                    std::copy(state.ui.benchmark.transform.metrics.begin(),
+                              state.ui.benchmark.transform.metrics.end(),
+                              std::ostream_iterator<TransformMetric>(os)
+                    );
+                }
+
+                ImGuiFileDialog::Instance()->Close();
+            }
+            ImGui::EndDisabled();
+
+            for (auto const &metric : state.ui.benchmark.transform.metrics)
+                ImGui::BulletText("%s (%zu vertices) %s: %.0f ns, %.3f ns per vertex",
+                                  metric.model.c_str(), metric.vertices, toString(metric.transform).c_str(),
+                                  metric.medianNs, metric.medianNs / static_cast<f64>(metric.vertices == 0 ? 1 : metric.vertices));
+
             ImGui::SeparatorText("Metrics");
 
             ImGui::BulletText("average time to calculate rotation matrix: %.2f ns (%.2f us)",
@@ -232,40 +387,116 @@ auto interface(State &state) -> void {
 
         if (ImGui::CollapsingHeader("Model")) {
             ImGui::BulletText("consisting of %d vertices and %d indices",
-                              state.model.vertices.size, state.model.indices.size);
+                              state.model.vertices.size, state.model.indexCount());
 
             ImGui::BulletText("loaded from file: %s",
                               state.ui.model.path.c_str());
 
-            ImGui::BeginDisabled(state.ui.benchmark.standard.enable || state.ui.benchmark.automated.enable);
+            ImGui::BulletText("load took %.2f ms%s",
+                              static_cast<f64>(state.ui.model.loadTimeNs) / 1'000'000.,
+                              state.model.cached ? " (from cache)" : "");
+
+            ImGui::BulletText("ACMR %.3f -> %.3f, ATVR %.3f -> %.3f (%zu entry FIFO)",
+                              state.model.cacheBefore.acmr, state.model.cacheAfter.acmr,
+                              state.model.cacheBefore.atvr, state.model.cacheAfter.atvr,
+                              obj::vertex_cache_size);
+            if (ImGui::IsItemHovered())
+                ImGui::SetTooltip("Post-transform cache misses per triangle and per vertex, in file order and as uploaded");
+
+            ImGui::BeginDisabled(state.ui.benchmark.standard.enable || state.ui.benchmark.automated.enable ||
+                                 state.load.running());
             if (ImGui::Button("Load"))
                 ImGuiFileDialog::Instance()->OpenDialog("ChooseFileDlgKey", "Choose File", ".obj", state.ui.model.path);
+            ImGui::SameLine();
+            ImGui::Checkbox("Optimize vertex order", &state.ui.model.optimizeVertexOrder);
+            ImGui::SameLine();
+            ImGui::Checkbox("Build LODs", &state.ui.model.buildLods);
 
             if (ImGuiFileDialog::Instance()->Display("ChooseFileDlgKey")) {
-                if (ImGuiFileDialog::Instance()->IsOk()) {
-                    state.ui.model.path = ImGuiFileDialog::Instance()->GetFilePathName();
-
-                    state.ui.model.ready            = false;
-                    state.ui.model.boundingBoxReady = false;
-
-                    loadModel(state.ui.model.path.c_str(),
-                              state.model, state.boundingBox,
-                              [](auto const &msg) { cwarn << msg << std::endl; });
-
-                    state.ui.model.ready            = true;
-                    state.ui.model.boundingBoxReady = true;
-                }
+                if (ImGuiFileDialog::Instance()->IsOk())
+                    startModelLoad(state, ImGuiFileDialog::Instance()->GetFilePathName());
 
                 ImGuiFileDialog::Instance()->Close();
             }
             ImGui::EndDisabled();
 
+            if (state.load.running()) {
+                ImGui::ProgressBar(state.load.progress.fraction.load(std::memory_order_relaxed), ImVec2{-FLT_MIN, 0.f});
+                ImGui::BeginDisabled(state.load.progress.is_cancelled());
+                if (ImGui::Button("Cancel"))
+                    state.load.progress.cancel();
+                ImGui::EndDisabled();
+                ImGui::SameLine();
+                ImGui::Text(state.load.progress.stage.load(std::memory_order_relaxed) == obj::load_stage::processing ? "optimizing %s" : "loading %s",
+                            state.load.path.c_str());
+            }
+            else if (!state.load.error.empty()) {
+                ImGui::PushStyleColor(ImGuiCol_Text, ImVec4{1.f, .4f, .4f, 1.f});
+                ImGui::TextWrapped("%s", state.load.error.c_str());
+                ImGui::PopStyleColor();
+            }
+
             ImGui::SeparatorText("Settings");
 
             ImGui::Checkbox("Draw model", &state.ui.model.draw);
 
             ImGui::Checkbox("Draw bounding box", &state.ui.model.drawBoundingBox);
 
+            ImGui::Checkbox("Quaternion shader", &state.ui.model.quaternionShader);
+            if (ImGui::IsItemHovered())
+                ImGui::SetTooltip("In Quaternion mode, rotate positions in the vertex shader instead of uploading a model matrix");
+
+            ImGui::Checkbox("Cull meshlets", &state.ui.model.cullMeshlets);
+            if (ImGui::IsItemHovered())
+                ImGui::SetTooltip("Meshlets cover the full level only, coarser levels are drawn whole");
+            ImGui::BeginDisabled(!state.ui.model.cullMeshlets);
+            ImGui::SameLine();
+            ImGui::Checkbox("Frustum", &state.ui.model.meshletCulling.frustum);
+            ImGui::SameLine();
+            ImGui::Checkbox("Back-facing", &state.ui.model.meshletCulling.backFacing);
+            if (ImGui::IsItemHovered())
+                ImGui::SetTooltip("Back faces are not culled by the pipeline, open meshes lose their inside when this is on");
+            {
+                auto const triangles = state.model.indexCount() / 3;
+                auto const culled    = state.ui.model.cullMeshlets && state.model.lod == 0 && triangles > 0
+                                           ? 1. - static_cast<f64>(state.model.drawnTriangles) / static_cast<f64>(triangles)
+                                           : 0.;
+                ImGui::Text("%zu meshlets, %.1f%% of triangles culled in %zu draw ranges",
+                            state.model.meshlets.size(), 100. * culled,
+                            state.ui.model.cullMeshlets && state.model.lod == 0 ? state.model.drawRanges.size() : usize{1});
+            }
+            ImGui::EndDisabled();
+
+            ImGui::Checkbox("Select LOD by screen size", &state.ui.model.selectLod);
+            if (state.ui.model.selectLod) {
+                ImGui::SliderFloat("Pixels per triangle", &state.ui.model.lodSelection.pixelsPerTriangle, 1.f, 1024.f, "%.1f",
+                                   ImGuiSliderFlags_Logarithmic);
+                ImGui::SliderFloat("Hysteresis", &state.ui.model.lodSelection.hysteresis, 0.f, .5f, "%.2f");
+            }
+            else
+                ImGui::SliderInt("Level", &state.ui.model.forcedLod, 0,
+                                 state.model.lods.empty() ? 0 : static_cast<i32>(state.model.lods.size() - 1));
+
+            ImGui::Text("bounding sphere spans %.0f px", state.model.lodDiameter);
+            for (usize level = 0; level < state.model.lods.size(); ++level) {
+                auto const triangles = state.model.lods[level].count / 3;
+                ImGui::BulletText("LOD %zu: %zu triangles (%.1f%%)%s", level, triangles,
+                                  100. * static_cast<f64>(triangles) / static_cast<f64>(math::max(state.model.indexCount() / 3, usize{1})),
+                                  level == state.model.lod ? "  <- drawn" : "");
+            }
+
+            ImGui::Checkbox("Draw trajectory", &state.ui.model.drawTrajectory);
+            ImGui::BeginDisabled(!state.ui.model.drawTrajectory);
+            ImGui::InputInt("Tracked vertex", &state.ui.model.trajectoryVertex);
+            state.ui.model.trajectoryVertex = std::clamp(
+                state.ui.model.trajectoryVertex, 0,
+                state.model.positions.empty() ? 0 : static_cast<i32>(state.model.positions.size() - 1)
+            );
+            ImGui::Text("Trajectory: %zu points from %zu orientations",
+                        state.trajectory.trajectory.points().size(),
+                        state.trajectory.trajectory.processed() + 1);
+            ImGui::EndDisabled();
+
             ImGui::ColorEdit4("Color", (float *)&state.model.color,
                               ImGuiColorEditFlags_NoInputs);
         }
@@ -275,7 +506,7 @@ auto interface(State &state) -> void {
             ImGui::SeparatorText("Mode");
             if (ImGui::RadioButton("Euler", state.ui.rotation.current.mode == RotationMode::Euler) &&
                 !state.ui.benchmark.standard.enable) {
-                state.ui.rotation.current = Rotation{RotationMode::Euler};
+                state.ui.rotation.current = Rotation{RotationMode::Euler, vector3<f32>{0.f}, state.ui.rotation.eulerOrder};
 
                 if (!state.ui.rotation.modeRotations[state.ui.rotation.current.mode].empty())
                     state.ui.rotation.modeRotationIndex =
@@ -301,7 +532,15 @@ auto interface(State &state) -> void {
             }
 
             if (state.ui.rotation.current.mode == RotationMode::Euler) {
-                ImGui::SeparatorText("Angles of rotation (XYZ or alpha-beta-gamma gimbal):");
+                ImGui::SeparatorText("Angles of rotation (alpha-beta-gamma gimbal):");
+
+                if (ImGui::BeginCombo("order", math::name(state.ui.rotation.eulerOrder))) {
+                    for (auto const order : euler_orders)
+                        if (ImGui::Selectable(math::name(order), order == state.ui.rotation.eulerOrder) &&
+                            order != state.ui.rotation.eulerOrder)
+                            setEulerOrder(state, order);
+                    ImGui::EndCombo();
+                }
 
                 ImGui::SliderAngle("alpha", &state.ui.rotation.current.compound.x);
                 ImGui::SliderAngle("beta", &state.ui.rotation.current.compound.y);
@@ -363,13 +602,9 @@ auto interface(State &state) -> void {
                 ImGui::SameLine();
                 if (ImGui::Button("Add") &&
                     state.ui.rotation.current.compound != vector3<f32>{0.f}) {
-                    state.ui.rotation.modeRotations[state.ui.rotation.current.mode].emplace_back(
-                        state.ui.rotation.current);
+                    addRotation(state, state.ui.rotation.current);
 
                     state.ui.rotation.current.compound = vector3<f32>{0.f};
-
-                    state.ui.rotation.modeRotationIndex =
-                        state.ui.rotation.modeRotations[state.ui.rotation.current.mode].size() - 1;
                 }
             }
             else {
@@ -387,33 +622,129 @@ auto interface(State &state) -> void {
                 if (ImGui::Button("Add") &&
                     state.ui.rotation.current.simple.angle != 0.f &&
                     state.ui.rotation.current.simple.axis != vector3<f32>{0.f}) {
-                    state.ui.rotation.modeRotations[state.ui.rotation.current.mode].emplace_back(
-                        state.ui.rotation.current);
+                    addRotation(state, state.ui.rotation.current);
 
                     state.ui.rotation.current.simple.angle = 0.f;
                     state.ui.rotation.current.simple.axis  = vector3<f32>{0.f};
-
-                    state.ui.rotation.modeRotationIndex =
-                        state.ui.rotation.modeRotations[state.ui.rotation.current.mode].size() - 1;
                 }
             }
 
             ImGui::SameLine();
-            if (ImGui::Button("Pop") && !state.ui.rotation.modeRotations[state.ui.rotation.current.mode].empty()) {
-                state.ui.rotation.modeRotations[state.ui.rotation.current.mode].pop_back();
+            if (ImGui::Button("Pop") && !state.ui.rotation.modeRotations[state.ui.rotation.current.mode].empty())
+                popRotation(state, state.ui.rotation.current.mode);
+            ImGui::SameLine();
+            if (ImGui::Button("Clear") && !state.ui.rotation.modeRotations[state.ui.rotation.current.mode].empty())
+                clearRotations(state, state.ui.rotation.current.mode);
+            ImGui::SameLine();
+            ImGui::BeginDisabled(state.ui.rotation.modeRotations[state.ui.rotation.current.mode].empty());
+            if (ImGui::Button("Export"))
+                ImGuiFileDialog::Instance()->OpenDialog("SaveRotationsDlgKey", "Choose a File", "CSV file (*.csv){.csv}", ".");
 
-                if (!state.ui.rotation.modeRotations[state.ui.rotation.current.mode].empty())
-                    state.ui.rotation.modeRotationIndex =
-                        state.ui.rotation.modeRotations[state.ui.rotation.current.mode].size() - 1;
+            if (ImGuiFileDialog::Instance()->Display("SaveRotationsDlgKey")) {
+                if (ImGuiFileDialog::Instance()->IsOk())
+                    saveRotations(ImGuiFileDialog::Instance()->GetFilePathName().c_str(),
+                                  state.ui.rotation.modeRotations[state.ui.rotation.current.mode],
+                                  [](auto const &msg) { cwarn << msg << std::endl; });
+
+                ImGuiFileDialog::Instance()->Close();
             }
+            ImGui::EndDisabled();
             ImGui::SameLine();
-            if (ImGui::Button("Clear") && !state.ui.rotation.modeRotations[state.ui.rotation.current.mode].empty()) {
-                state.ui.rotation.modeRotations[state.ui.rotation.current.mode].clear();
+            if (ImGui::Button("Import"))
+                ImGuiFileDialog::Instance()->OpenDialog("ChooseRotationsDlgKey", "Choose File", ".csv,.txt",
+                                                        state.ui.rotation.importPath);
+
+            if (ImGuiFileDialog::Instance()->Display("ChooseRotationsDlgKey")) {
+                if (ImGuiFileDialog::Instance()->IsOk()) {
+                    state.ui.rotation.importPath = ImGuiFileDialog::Instance()->GetFilePathName();
+
+                    for (auto const &rotation : loadRotations(state.ui.rotation.importPath.c_str(),
+                                                              state.ui.rotation.current.mode,
+                                                              state.ui.rotation.eulerOrder,
+                                                              [](auto const &msg) { cwarn << msg << std::endl; }))
+                        addRotation(state, rotation);
+                }
 
-                state.ui.rotation.modeRotationIndex = 0;
+                ImGuiFileDialog::Instance()->Close();
             }
             ImGui::EndDisabled();
 
+            ImGui::SeparatorText("Mean rotation");
+            {
+                auto const live = Rotation::from(RotationMode::Quaternion,
+                                                 state.ui.rotation.modeMeans[state.ui.rotation.current.mode].mean());
+                ImGui::BulletText("streaming mean of %zu rotations: %.2f deg about [%.3f, %.3f, %.3f]",
+                                  state.ui.rotation.modeMeans[state.ui.rotation.current.mode].count(),
+                                  math::degrees(live.simple.angle),
+                                  live.simple.axis.x, live.simple.axis.y, live.simple.axis.z);
+
+                ImGui::BeginDisabled(state.ui.rotation.modeRotations[state.ui.rotation.current.mode].empty());
+                if (ImGui::Button("Average")) {
+                    state.ui.rotation.average.count  = state.ui.rotation.modeRotations[state.ui.rotation.current.mode].size();
+                    state.ui.rotation.average.timeNs = perf::benchmark<std::chrono::high_resolution_clock, std::chrono::nanoseconds>(
+                        [&]() { state.ui.rotation.average.mean = averageRotations(state.ui.rotation.modeRotations[state.ui.rotation.current.mode]); }
+                    );
+                }
+                ImGui::EndDisabled();
+
+                auto const batch = Rotation::from(RotationMode::Quaternion, state.ui.rotation.average.mean);
+                ImGui::SameLine();
+                ImGui::Text("mean of %zu rotations: %.2f deg about [%.3f, %.3f, %.3f] (took %.2f us)",
+                            state.ui.rotation.average.count,
+                            math::degrees(batch.simple.angle),
+                            batch.simple.axis.x, batch.simple.axis.y, batch.simple.axis.z,
+                            static_cast<f64>(state.ui.rotation.average.timeNs) / 1000.);
+            }
+
+            ImGui::SeparatorText("Neighbours");
+            {
+                auto &neighbours = state.ui.rotation.neighbours;
+                auto &rotations  = state.ui.rotation.modeRotations[state.ui.rotation.current.mode];
+
+                ImGui::Checkbox("Skip duplicates within", &neighbours.dedupe);
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(80.f);
+                ImGui::DragFloat("deg##dedupe", &neighbours.dedupeDegrees, .01f, 0.f, 180.f, "%.2f");
+                ImGui::SameLine();
+                ImGui::Text("(%zu skipped)", neighbours.skipped);
+
+                ImGui::SetNextItemWidth(80.f);
+                ImGui::DragFloat("deg##radius", &neighbours.radiusDegrees, .1f, 0.f, 180.f, "%.1f");
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(80.f);
+                ImGui::InputInt("k", &neighbours.count);
+                neighbours.count = std::max(neighbours.count, 1);
+
+                ImGui::BeginDisabled(rotations.empty() || state.ui.rotation.modeRotationIndex >= rotations.size());
+                auto const query = [&](auto const &search) {
+                    auto const quat = rotations[state.ui.rotation.modeRotationIndex].toQuaternion();
+
+                    std::vector<quaternion_tree<f32>::neighbour> found{};
+                    neighbours.timeNs = perf::benchmark<std::chrono::high_resolution_clock, std::chrono::nanoseconds>(
+                        [&]() { found = search(state.ui.rotation.modeIndices[state.ui.rotation.current.mode], quat); }
+                    );
+
+                    neighbours.mode = state.ui.rotation.current.mode;
+                    neighbours.matches.clear();
+                    for (auto const &neighbour : found)
+                        neighbours.matches.emplace(neighbour.id, math::degrees(neighbour.angle));
+                };
+                if (ImGui::Button("Within"))
+                    query([&](quaternion_tree<f32> const &index, quaternion<f32> const &quat) { return index.radius(quat, math::radians(neighbours.radiusDegrees)); });
+                ImGui::SameLine();
+                if (ImGui::Button("Nearest"))
+                    query([&](quaternion_tree<f32> const &index, quaternion<f32> const &quat) { return index.nearest(quat, static_cast<usize>(neighbours.count)); });
+                ImGui::EndDisabled();
+                ImGui::SameLine();
+                if (ImGui::Button("Reset"))
+                    neighbours.matches.clear();
+
+                ImGui::BulletText("%zu matches around R%zu (took %.2f us)",
+                                  neighbours.matches.size(),
+                                  state.ui.rotation.modeRotationIndex,
+                                  static_cast<f64>(neighbours.timeNs) / 1000.);
+            }
+
             {
                 char text[32];
                 sprintf(text, "Rotations (%zu)",
@@ -429,8 +760,19 @@ auto interface(State &state) -> void {
                     char text[256];
                     sprintf(text, "R%d - %s", i,
                             state.ui.rotation.modeRotations[state.ui.rotation.current.mode].at(i).toString().c_str());
+
+                    auto const match = state.ui.rotation.neighbours.mode == state.ui.rotation.current.mode
+                                           ? state.ui.rotation.neighbours.matches.find(i)
+                                           : state.ui.rotation.neighbours.matches.end();
+                    if (match != state.ui.rotation.neighbours.matches.end()) {
+                        auto const length = std::strlen(text);
+                        snprintf(text + length, sizeof(text) - length, " (%.2f deg)", match->second);
+                        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4{1.f, .8f, .2f, 1.f});
+                    }
                     if (ImGui::Selectable(text, state.ui.rotation.modeRotationIndex == i))
                         state.ui.rotation.modeRotationIndex = i;
+                    if (match != state.ui.rotation.neighbours.matches.end())
+                        ImGui::PopStyleColor();
                 }
                 ImGui::EndChild();
             }
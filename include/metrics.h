@@ -9,6 +9,8 @@
 
 #include <micro-engine/micro.h>
 
+#include "transform.h"
+
 using namespace micro;
 using namespace micro::core;
 
@@ -17,10 +19,16 @@ struct BenchmarkMetric {
     usize                         indices;
     usize                         rotations;
     std::chrono::nanoseconds::rep time;
+    math::kernel_variant          kernel;
+    VertexTransform               transform;
+    std::chrono::nanoseconds::rep transformTime;
 
     friend fn operator<<(std::ostream &os, BenchmarkMetric const &bm) -> std::ostream &;
 };
 
-fn operator<<(std::ostream &os, BenchmarkMetric const &bm) -> std::ostream & { return os << bm.vertices << ',' << bm.indices << ',' << bm.rotations << ',' << bm.time << '\n'; }
+fn operator<<(std::ostream &os, BenchmarkMetric const &bm) -> std::ostream & {
+    return os << bm.vertices << ',' << bm.indices << ',' << bm.rotations << ',' << bm.time << ',' << math::name(bm.kernel) << ','
+              << toString(bm.transform) << ',' << bm.transformTime << '\n';
+}
 
 #endif //FINAL_METRICS_H
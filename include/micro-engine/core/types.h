@@ -77,8 +77,9 @@ namespace micro::core {
                 auto const diff1 = &((static_cast<Orig const *>(&union_part->base))->*member);
                 auto const diff2 = &union_part->pad.m;
                 if (diff1 > diff2) {
-                    constexpr auto MIN = sizeof(Member) < alignof(Orig) ? sizeof(Member) : alignof(Orig);
-                    return offset2<off + MIN>(member);
+                    // a member always sits at a multiple of its own alignment, stepping by its size instead skips the
+                    // offset of a 12-byte vector behind a 16-byte aligned one
+                    return offset2<off + alignof(Member)>(member);
                 }
                 else
                     return off;
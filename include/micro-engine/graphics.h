@@ -5,8 +5,11 @@
 #ifndef MICRO_GRAPHICS_H
 #define MICRO_GRAPHICS_H
 
+#include "graphics/attribute.h"
 #include "graphics/bounding-box.h"
 #include "graphics/buffer.h"
+#include "graphics/lod.h"
+#include "graphics/meshlet.h"
 #include "graphics/model.h"
 #include "graphics/shader.h"
 #include "graphics/texture.h"
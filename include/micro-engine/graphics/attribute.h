@@ -0,0 +1,172 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+#ifndef MICRO_GRAPHICS_ATTRIBUTE_H
+#define MICRO_GRAPHICS_ATTRIBUTE_H
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "../core/types.h"
+#include "../mathematics/linear.h"
+
+namespace micro::graphics {
+    // what a vertex attribute means to a shader, a model binds each to the location the shader gives it
+    enum class attribute_semantic : core::u8 {
+        position,
+        uv,
+        normal,
+        color
+    };
+
+    // how an attribute is stored, model.h maps each to the gl type, component count and normalization
+    enum class attribute_format : core::u8 {
+        // 12 bytes
+        f32x3,
+        // 16 bytes
+        f32x4,
+        // 8 bytes, half floats with w stored as well so the next attribute stays 4-byte aligned
+        f16x4,
+        // 4 bytes, signed normalized 10:10:10:2 with x in the low bits, the 2-bit w is 0
+        snorm10x3,
+        // 4 bytes, unsigned normalized
+        unorm16x2
+    };
+
+    constexpr fn bytes(attribute_format format) -> core::usize {
+        switch (format) {
+            default:
+            case attribute_format::f32x3: return 12;
+            case attribute_format::f32x4: return 16;
+            case attribute_format::f16x4: return 8;
+            case attribute_format::snorm10x3:
+            case attribute_format::unorm16x2: return 4;
+        }
+    }
+
+    // one attribute of a vertex layout, the member it is read from and how the shader sees it
+    template<auto Member, attribute_semantic Semantic, attribute_format Format>
+    struct attribute {
+        static constexpr auto               member   = Member;
+        static constexpr attribute_semantic semantic = Semantic;
+        static constexpr attribute_format   format   = Format;
+
+        static fn offset() -> std::ptrdiff_t { return core::offset_of<Member>(); }
+    };
+
+    template<typename... Attributes>
+    struct attribute_list {};
+
+    namespace internal {
+        template<typename... Attributes, typename F>
+        constexpr fn for_each_attribute(attribute_list<Attributes...>, F &&function) -> void { (function(Attributes{}), ...); }
+    }
+
+    // calls the function with every attribute of the layout, in declaration order
+    template<typename V, typename F>
+    constexpr fn for_each_attribute(F &&function) -> void {
+        internal::for_each_attribute(typename V::attributes{}, std::forward<F>(function));
+    }
+
+    // identifies the attributes, formats and stride of a layout, two layouts with the same size but different contents
+    // never compare equal, used to tell cached vertex arrays apart
+    template<typename V>
+    fn layout_signature() -> std::uint32_t {
+        std::uint32_t res = 2'166'136'261u ^ static_cast<std::uint32_t>(sizeof(V));
+        for_each_attribute<V>([&]<typename A>(A) {
+            for (auto const value : {static_cast<std::uint32_t>(A::semantic), static_cast<std::uint32_t>(A::format),
+                                     static_cast<std::uint32_t>(A::offset())})
+                res = (res ^ value) * 16'777'619u;
+        });
+        return res;
+    }
+
+    // round to nearest even, out of range values become infinity and values below the smallest subnormal zero
+    constexpr fn pack_half(core::f32 value) -> core::u16 {
+        auto const bits     = std::bit_cast<std::uint32_t>(value);
+        auto const sign     = static_cast<std::uint32_t>((bits >> 16) & 0x8000u);
+        auto const exponent = static_cast<core::i32>((bits >> 23) & 0xffu);
+        auto       mantissa = bits & 0x7fffffu;
+
+        if (exponent == 0xff)
+            return static_cast<core::u16>(sign | 0x7c00u | (mantissa != 0 ? 0x200u : 0u));
+
+        auto const biased = exponent - 127 + 15;
+        if (biased >= 0x1f)
+            return static_cast<core::u16>(sign | 0x7c00u);
+
+        if (biased <= 0) {
+            if (biased < -10)
+                return static_cast<core::u16>(sign);
+
+            mantissa |= 0x800000u;
+            auto const shift     = static_cast<std::uint32_t>(14 - biased);
+            auto const half      = mantissa >> shift;
+            auto const remainder = mantissa & ((1u << shift) - 1u);
+            auto const middle    = 1u << (shift - 1u);
+            return static_cast<core::u16>(sign | (half + (remainder > middle || (remainder == middle && (half & 1u)) ? 1u : 0u)));
+        }
+
+        // a carry out of the mantissa moves into the exponent, the largest values round up to infinity
+        auto       half      = (static_cast<std::uint32_t>(biased) << 10) | (mantissa >> 13);
+        auto const remainder = mantissa & 0x1fffu;
+        if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u)))
+            ++half;
+        return static_cast<core::u16>(sign | half);
+    }
+
+    constexpr fn unpack_half(core::u16 half) -> core::f32 {
+        auto const sign     = static_cast<std::uint32_t>(half & 0x8000u) << 16;
+        auto const exponent = static_cast<std::uint32_t>((half >> 10) & 0x1fu);
+        auto const mantissa = static_cast<std::uint32_t>(half & 0x3ffu);
+
+        if (exponent == 0) {
+            auto const magnitude = static_cast<core::f32>(mantissa) * (1.f / 16'777'216.f);
+            return sign != 0 ? -magnitude : magnitude;
+        }
+        if (exponent == 0x1f)
+            return std::bit_cast<core::f32>(sign | 0x7f800000u | (mantissa << 13));
+        return std::bit_cast<core::f32>(sign | ((exponent + 112u) << 23) | (mantissa << 13));
+    }
+
+    constexpr fn pack_half4(math::vector4<core::f32> const &value) -> std::array<core::u16, 4> {
+        return {pack_half(value.x), pack_half(value.y), pack_half(value.z), pack_half(value.w)};
+    }
+
+    // normals only carry a direction, they are normalized first so the full range is used, a zero vector stays zero
+    fn pack_snorm10x3(math::vector3<core::f32> value) -> std::uint32_t {
+        if (auto const length = math::magnitude(value); length > 0.f)
+            value = value / length;
+
+        auto const component = [](core::f32 c) -> std::uint32_t {
+            auto const clamped = c < -1.f ? -1.f : (c > 1.f ? 1.f : c);
+            auto const scaled  = clamped * 511.f;
+            return static_cast<std::uint32_t>(static_cast<core::i32>(scaled < 0.f ? scaled - .5f : scaled + .5f)) & 0x3ffu;
+        };
+        return component(value.x) | (component(value.y) << 10) | (component(value.z) << 20);
+    }
+
+    constexpr fn unpack_snorm10x3(std::uint32_t packed) -> math::vector3<core::f32> {
+        auto const component = [&](std::uint32_t shift) {
+            auto const bits  = static_cast<core::i32>((packed >> shift) & 0x3ffu);
+            auto const value = static_cast<core::f32>(bits >= 512 ? bits - 1024 : bits) / 511.f;
+            return value < -1.f ? -1.f : value;
+        };
+        return math::vector3<core::f32>{component(0), component(10), component(20)};
+    }
+
+    // coordinates outside [0, 1] are clamped, tiling uvs need a float layout
+    constexpr fn pack_unorm16x2(core::f32 u, core::f32 v) -> std::array<core::u16, 2> {
+        auto const component = [](core::f32 c) {
+            auto const clamped = c < 0.f ? 0.f : (c > 1.f ? 1.f : c);
+            return static_cast<core::u16>(clamped * 65'535.f + .5f);
+        };
+        return {component(u), component(v)};
+    }
+}
+
+#endif //MICRO_GRAPHICS_ATTRIBUTE_H
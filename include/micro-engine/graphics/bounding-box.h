@@ -8,8 +8,12 @@
 #include <numeric>
 #include <vector>
 
+#include "../core/minmax.h"
 #include "../core/types.h"
+#include "../mathematics/dispatch.h"
 #include "../mathematics/linear.h"
+#include "../mathematics/soa.h"
+#include "vertex.h"
 
 namespace micro::graphics {
     struct BoundingBox {
@@ -117,13 +121,29 @@ namespace micro::graphics {
             return boundingBox;
         }
 
-        static fn from(std::vector<Vertex> const &vertices) -> BoundingBox {
+        // vectorized per-lane reduction instead of three compares per vertex, runs the kernel variant selected for bounds
+        static fn from(math::soa_vector3<core::f32> const &positions) -> BoundingBox {
+            if (positions.empty())
+                return BoundingBox{};
+
+            auto const [lo, hi] = math::bounds(positions);
+            return BoundingBox{
+                core::minmax<core::f32>{lo.x, hi.x},
+                core::minmax<core::f32>{lo.y, hi.y},
+                core::minmax<core::f32>{lo.z, hi.z}
+            };
+        }
+
+        // of the positions as the layout stores them, so a quantized layout is bounded by what is drawn
+        template<vertex_layout V>
+        static fn from(std::vector<V> const &vertices) -> BoundingBox {
             BoundingBox boundingBox{};
 
             for (auto const &vertex : vertices) {
-                boundingBox.x.assign(vertex.position.x);
-                boundingBox.y.assign(vertex.position.y);
-                boundingBox.z.assign(vertex.position.z);
+                auto const position = position_of(vertex);
+                boundingBox.x.assign(position.x);
+                boundingBox.y.assign(position.y);
+                boundingBox.z.assign(position.z);
             }
 
             return boundingBox;
@@ -0,0 +1,59 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+#ifndef MICRO_GRAPHICS_LOD_H
+#define MICRO_GRAPHICS_LOD_H
+
+#include <limits>
+#include <numbers>
+#include <span>
+
+#include "../core/types.h"
+#include "../mathematics/linear.h"
+#include "meshlet.h"
+
+namespace micro::graphics {
+    struct LodSelection {
+        // screen area every drawn triangle should cover at least, in pixels
+        core::f32 pixelsPerTriangle = 8.f;
+        // relative change of the projected size a level has to see past its threshold before it is switched, keeps a
+        // model sitting on a threshold from switching every frame
+        core::f32 hysteresis = .15f;
+    };
+
+    // diameter in pixels of a sphere seen by a perspective camera with the given vertical field of view, a camera
+    // inside the sphere sees it fill the screen
+    fn projected_diameter(core::f32 radius, core::f32 distance, core::f32 fovY, core::f32 viewportHeight) -> core::f32 {
+        if (distance <= radius)
+            return std::numeric_limits<core::f32>::max();
+        return radius / (distance * math::tan(fovY / 2.f)) * viewportHeight;
+    }
+
+    // the finest level whose triangles each cover the wanted screen area of a disc of the given diameter, the coarsest
+    // when none does, the current level is kept while it would still be picked with the diameter moved by the
+    // hysteresis towards it, levels are ordered from the finest
+    fn select_lod(std::span<IndexRange const> levels, core::f32 diameter, core::usize current, LodSelection selection) -> core::usize {
+        if (levels.empty())
+            return 0;
+
+        auto const pick = [&](core::f32 d) -> core::usize {
+            auto const area = .25f * std::numbers::pi_v<core::f32> * d * d;
+            for (core::usize level = 0; level < levels.size(); ++level)
+                if (static_cast<core::f32>(levels[level].count / 3) * selection.pixelsPerTriangle <= area)
+                    return level;
+            return levels.size() - 1;
+        };
+
+        // finer levels come first, a larger diameter picks a finer or the same level
+        auto const finest   = pick(diameter * (1.f + selection.hysteresis));
+        auto const coarsest = pick(diameter * (1.f - selection.hysteresis));
+        if (current < finest)
+            return finest;
+        if (current > coarsest)
+            return coarsest;
+        return current;
+    }
+}
+
+#endif //MICRO_GRAPHICS_LOD_H
@@ -0,0 +1,194 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+#ifndef MICRO_GRAPHICS_MESHLET_H
+#define MICRO_GRAPHICS_MESHLET_H
+
+#include <array>
+#include <concepts>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "../core/types.h"
+#include "../mathematics/linear.h"
+#include "vertex.h"
+
+namespace micro::graphics {
+    inline constexpr core::usize meshlet_max_vertices  = 64;
+    inline constexpr core::usize meshlet_max_triangles = 124;
+
+    // a run of consecutive triangles of the index buffer with the bounds it is culled by, all in model space
+    struct Meshlet {
+        core::usize firstIndex    = 0;
+        core::usize triangleCount = 0;
+        core::usize vertexCount   = 0;
+
+        math::vector3<core::f32> center{0.f};
+        core::f32                radius = 0.f;
+
+        // every triangle normal is within the cone's half angle of the axis, a cone of 90 degrees or more (cosine at
+        // most 0) never faces away from the camera as a whole
+        math::vector3<core::f32> coneAxis{0.f, 0.f, 1.f};
+        core::f32                coneCos = -1.f;
+        core::f32                coneSin = 0.f;
+    };
+
+    // indices a draw call reads, in elements of the index buffer
+    struct IndexRange {
+        core::usize first = 0;
+        core::usize count = 0;
+    };
+
+    // the six clip planes of a model-view-projection matrix (Gribb, Hartmann), in the space the matrix maps from, with
+    // normals pointing inwards and normalized so distances are in that space's units
+    struct Frustum {
+        std::array<math::vector4<core::f32>, 6> planes{};
+
+        static fn from(math::matrix4x4<core::f32> const &mvp) -> Frustum {
+            auto const row = [&](core::usize i) { return math::vector4<core::f32>{mvp[0][i], mvp[1][i], mvp[2][i], mvp[3][i]}; };
+
+            Frustum res{};
+            res.planes = {row(3) + row(0), row(3) - row(0), row(3) + row(1), row(3) - row(1), row(3) + row(2), row(3) - row(2)};
+            for (auto &plane : res.planes)
+                plane = plane / math::magnitude(math::vector3<core::f32>{plane});
+            return res;
+        }
+
+        // false only when the sphere lies entirely outside one of the planes
+        [[nodiscard]] fn intersects(math::vector3<core::f32> const &center, core::f32 radius) const -> bool {
+            for (auto const &plane : planes)
+                if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius)
+                    return false;
+            return true;
+        }
+    };
+
+    // splits the triangle list into meshlets of consecutive triangles, a meshlet closes when the next triangle would
+    // bring in more than maxVertices distinct vertices or exceed maxTriangles, run after optimize_vertex_cache the
+    // consecutive triangles are also spatially close, which keeps the bounds tight
+    template<vertex_layout V, std::unsigned_integral T>
+    fn build_meshlets(std::span<V const> vertices,
+                      std::span<T const> indices,
+                      core::usize        maxVertices  = meshlet_max_vertices,
+                      core::usize        maxTriangles = meshlet_max_triangles) -> std::vector<Meshlet> {
+        std::vector<Meshlet> res{};
+
+        // the meshlet a vertex was last counted in, so distinct vertices are counted without clearing a set
+        constexpr auto           none = std::numeric_limits<core::usize>::max();
+        std::vector<core::usize> owner(vertices.size(), none);
+
+        std::vector<math::vector3<core::f32>> points{};
+        std::vector<math::vector3<core::f32>> normals{};
+        auto const                            close = [&](Meshlet meshlet) {
+            auto lo = points.front(), hi = points.front();
+            for (auto const &point : points) {
+                lo = math::vector3<core::f32>{math::min(lo.x, point.x), math::min(lo.y, point.y), math::min(lo.z, point.z)};
+                hi = math::vector3<core::f32>{math::max(hi.x, point.x), math::max(hi.y, point.y), math::max(hi.z, point.z)};
+            }
+            meshlet.center = (lo + hi) * .5f;
+            for (auto const &point : points)
+                meshlet.radius = math::max(meshlet.radius, math::distance(meshlet.center, point));
+
+            // unit normals so large triangles do not hide the spread of small ones, degenerate ones carry no direction
+            math::vector3<core::f32> sum{0.f};
+            for (auto const &normal : normals)
+                sum = sum + normal;
+            if (auto const length = math::magnitude(sum); length > 1.e-6f && !normals.empty()) {
+                meshlet.coneAxis = sum / length;
+                meshlet.coneCos  = 1.f;
+                for (auto const &normal : normals)
+                    meshlet.coneCos = math::min(meshlet.coneCos, math::dot(meshlet.coneAxis, normal));
+                meshlet.coneSin = math::sqrt(math::max(0.f, 1.f - meshlet.coneCos * meshlet.coneCos));
+            }
+
+            res.push_back(meshlet);
+            points.clear();
+            normals.clear();
+        };
+
+        Meshlet current{};
+        for (core::usize first = 0; first + 2 < indices.size(); first += 3) {
+            core::usize fresh = 0;
+            for (core::usize corner = 0; corner < 3; ++corner)
+                fresh += owner[indices[first + corner]] != res.size() ? 1 : 0;
+
+            if (current.triangleCount == maxTriangles || current.vertexCount + fresh > maxVertices) {
+                close(current);
+                current = Meshlet{first};
+                fresh   = 3;
+            }
+
+            for (core::usize corner = 0; corner < 3; ++corner) {
+                auto const index = indices[first + corner];
+                if (owner[index] != res.size()) {
+                    owner[index] = res.size();
+                    ++current.vertexCount;
+                    points.push_back(position_of(vertices[index]));
+                }
+            }
+            ++current.triangleCount;
+
+            auto const a = position_of(vertices[indices[first]]);
+            auto const n = math::cross(position_of(vertices[indices[first + 1]]) - a, position_of(vertices[indices[first + 2]]) - a);
+            if (auto const length = math::magnitude(n); length > 0.f)
+                normals.push_back(n / length);
+        }
+        if (current.triangleCount > 0)
+            close(current);
+
+        return res;
+    }
+
+    // true when every triangle of the meshlet faces away from a camera at the given model-space position, triangles are
+    // front facing when counter-clockwise, a camera inside the bounding sphere never culls
+    fn is_back_facing(Meshlet const &meshlet, math::vector3<core::f32> const &camera) -> bool {
+        if (meshlet.coneCos <= 0.f)
+            return false;
+
+        auto const offset   = meshlet.center - camera;
+        auto const distance = math::magnitude(offset);
+        if (distance <= meshlet.radius)
+            return false;
+
+        // the normal closest to facing the camera is at most the cone's half angle further from the view direction
+        // than the axis, the sphere radius widens the view directions the meshlet is seen under
+        auto const cosView = math::dot(offset, meshlet.coneAxis) / distance;
+        auto const sinView = math::sqrt(math::max(0.f, 1.f - cosView * cosView));
+        return cosView * meshlet.coneCos - sinView * meshlet.coneSin > meshlet.radius / distance;
+    }
+
+    struct MeshletCulling {
+        bool frustum    = true;
+        bool backFacing = true;
+    };
+
+    // the index ranges of the meshlets that survive culling, neighbouring ones merged into a single range, returns the
+    // number of triangles left to draw
+    fn cull_meshlets(std::span<Meshlet const>           meshlets,
+                     math::matrix4x4<core::f32> const &mvp,
+                     math::vector3<core::f32> const &  camera,
+                     MeshletCulling                    culling,
+                     std::vector<IndexRange> &         ranges) -> core::usize {
+        ranges.clear();
+
+        auto const  frustum   = Frustum::from(mvp);
+        core::usize triangles = 0;
+        for (auto const &meshlet : meshlets) {
+            if ((culling.frustum && !frustum.intersects(meshlet.center, meshlet.radius)) ||
+                (culling.backFacing && is_back_facing(meshlet, camera)))
+                continue;
+
+            triangles += meshlet.triangleCount;
+            if (!ranges.empty() && ranges.back().first + ranges.back().count == meshlet.firstIndex)
+                ranges.back().count += 3 * meshlet.triangleCount;
+            else
+                ranges.push_back(IndexRange{meshlet.firstIndex, 3 * meshlet.triangleCount});
+        }
+
+        return triangles;
+    }
+}
+
+#endif //MICRO_GRAPHICS_MESHLET_H
@@ -7,13 +7,37 @@
 
 #include <glad/glad.h>
 
+#include <span>
+#include <type_traits>
 #include <unordered_set>
 
+#include "attribute.h"
 #include "buffer.h"
+#include "meshlet.h"
+#include "vertex.h"
 #include "../core/types.h"
 #include "../utils/conversion.h"
 
 namespace micro::graphics {
+    namespace internal {
+        struct gl_attribute_format {
+            GLenum type;
+            GLint  size;
+            bool   normalized;
+        };
+
+        constexpr fn to_gl(attribute_format format) -> gl_attribute_format {
+            switch (format) {
+                default:
+                case attribute_format::f32x3: return {GL_FLOAT, 3, false};
+                case attribute_format::f32x4: return {GL_FLOAT, 4, false};
+                case attribute_format::f16x4: return {GL_HALF_FLOAT, 4, false};
+                case attribute_format::snorm10x3: return {GL_INT_2_10_10_10_REV, 4, true};
+                case attribute_format::unorm16x2: return {GL_UNSIGNED_SHORT, 2, true};
+            }
+        }
+    }
+
     class Model {
     public:
         enum class Primitive : GLenum {
@@ -98,11 +122,20 @@ namespace micro::graphics {
             requires std::is_arithmetic_v<U>
         fn buffer(GLuint binding, Buffer &buf, bool normalized = false) -> Model &;
 
+        // one attribute pointer per attribute of the layout, placed with core::offset_of, location returns the shader
+        // location of a semantic or -1 for one the shader does not read, which is left unbound
+        template<vertex_layout V, typename F>
+            requires std::is_invocable_r_v<GLint, F, attribute_semantic>
+        fn layout(Buffer &buf, F &&location) -> Model &;
+
         template<std::unsigned_integral U>
         fn index(Buffer &buf) -> Model &;
 
         fn render(Primitive mode = Primitive::Triangle) -> Model &;
 
+        // one indexed draw per range, the ranges are in elements of the index buffer
+        fn render(std::span<IndexRange const> ranges, Primitive mode = Primitive::Triangle) -> Model &;
+
         static fn polygon(Face face, Polygon mode) -> void;
 
     private:
@@ -291,6 +324,33 @@ namespace micro::graphics {
         return *this;
     }
 
+    template<vertex_layout V, typename F>
+        requires std::is_invocable_r_v<GLint, F, attribute_semantic>
+    fn Model::layout(Buffer &_buf, F &&_location) -> Model & {
+        _buf.bind();
+        for_each_attribute<V>([&]<typename A>(A) {
+            auto const binding = static_cast<GLint>(_location(A::semantic));
+            if (binding < 0)
+                return;
+
+            constexpr auto format = internal::to_gl(A::format);
+            glVertexAttribPointer(static_cast<GLuint>(binding),
+                                  format.size,
+                                  format.type,
+                                  format.normalized ? GL_TRUE : GL_FALSE,
+                                  sizeof(V),
+                                  reinterpret_cast<void const *>(A::offset()));
+            glEnableVertexAttribArray(static_cast<GLuint>(binding));
+
+            bindings.insert(static_cast<GLuint>(binding));
+        });
+        _buf.unbind();
+
+        verticesCount = _buf.size;
+
+        return *this;
+    }
+
     template<std::unsigned_integral U>
     fn Model::index(Buffer &_buf) -> Model & {
         ebo          = const_cast<Buffer *>(&_buf);
@@ -311,6 +371,23 @@ namespace micro::graphics {
         return *this;
     }
 
+    fn Model::render(std::span<IndexRange const> _ranges, Primitive _mode) -> Model & {
+        if (ebo == nullptr)
+            return *this;
+
+        auto const indexSize = eboValueType == GL_UNSIGNED_BYTE ? 1 : (eboValueType == GL_UNSIGNED_SHORT ? 2 : 4);
+
+        ebo->bind();
+        for (auto const &range : _ranges)
+            glDrawElements(static_cast<GLenum>(_mode),
+                           static_cast<GLsizei>(range.count),
+                           eboValueType,
+                           reinterpret_cast<void const *>(range.first * indexSize));
+        ebo->unbind();
+
+        return *this;
+    }
+
     auto Model::polygon(Face _face, Polygon _mode) -> void {
         glPolygonMode(static_cast<GLenum>(_face), static_cast<GLenum>(_mode));
     }
@@ -453,6 +453,14 @@ namespace micro::graphics {
         return *this;
     }
 
+    // rows are stored contiguously, uploaded transposed into a GLSL mat4x3
+    template<>
+    fn Shader::uniform(std::string const &name, math::affine3x4<core::f32> const &u) -> Shader & {
+        glUniformMatrix4x3fv(uniform(name), 1, GL_TRUE, math::value_ptr(u));
+
+        return *this;
+    }
+
     template<>
     fn Shader::uniform(std::string const &name, math::vector2<core::f32> &u) -> Shader & {
         glUniform2fv(uniform(name), 1, math::value_ptr(u));
@@ -501,6 +509,14 @@ namespace micro::graphics {
 
         return *this;
     }
+
+    // rows are stored contiguously, uploaded transposed into a GLSL mat4x3
+    template<>
+    fn Shader::uniform(std::string const &name, math::affine3x4<core::f32> &u) -> Shader & {
+        glUniformMatrix4x3fv(uniform(name), 1, GL_TRUE, math::value_ptr(u));
+
+        return *this;
+    }
 }
 
 #endif //MICRO_GRAPHICS_SHADER_H
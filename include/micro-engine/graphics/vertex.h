@@ -5,8 +5,13 @@
 #ifndef MICRO_GRAPHICS_VERTEX_H
 #define MICRO_GRAPHICS_VERTEX_H
 
+#include <array>
+#include <concepts>
+#include <cstdint>
+
 #include "../core/types.h"
 #include "../mathematics/linear.h"
+#include "attribute.h"
 
 namespace micro::graphics {
     struct Vertex {
@@ -15,6 +20,13 @@ namespace micro::graphics {
         math::vector3<core::f32> normals{};
         math::vector3<core::f32> color{};
 
+        using attributes = attribute_list<
+            attribute<&Vertex::position, attribute_semantic::position, attribute_format::f32x4>,
+            attribute<&Vertex::uv, attribute_semantic::uv, attribute_format::f32x3>,
+            attribute<&Vertex::normals, attribute_semantic::normal, attribute_format::f32x3>,
+            attribute<&Vertex::color, attribute_semantic::color, attribute_format::f32x3>
+        >;
+
         constexpr explicit Vertex() = default;
 
         constexpr explicit Vertex(math::vector4<core::f32> const &position);
@@ -31,6 +43,10 @@ namespace micro::graphics {
                                  math::vector3<core::f32> const &normals,
                                  math::vector3<core::f32> const &color);
 
+        static constexpr fn pack(math::vector4<core::f32> const &position,
+                                 math::vector3<core::f32> const &uv,
+                                 math::vector3<core::f32> const &normals) -> Vertex;
+
         constexpr friend fn operator==(Vertex const &v1, Vertex const &v2) -> bool;
 
         constexpr friend fn operator!=(Vertex const &v1, Vertex const &v2) -> bool;
@@ -61,6 +77,105 @@ namespace micro::graphics {
                               math::vector3<core::f32> const &uv,
                               math::vector3<core::f32> const &normals,
                               math::vector3<core::f32> const &color) { return Vertex{position, uv, normals, color}; }
+
+    constexpr fn Vertex::pack(math::vector4<core::f32> const &position,
+                              math::vector3<core::f32> const &uv,
+                              math::vector3<core::f32> const &normals) -> Vertex { return Vertex{position, uv, normals, math::vector3<core::f32>{0}}; }
+
+    constexpr fn position_of(Vertex const &vertex) -> math::vector3<core::f32> { return math::vector3<core::f32>{vertex.position}; }
+
+    // the layouts below keep only what a shader reads, the loader packs straight into them and Model::layout binds
+    // their attributes, the w of a position is dropped by the three-component ones
+
+    // 12 bytes, for shaders that only read a_position
+    struct PositionVertex {
+        math::vector3<core::f32> position{};
+
+        using attributes = attribute_list<
+            attribute<&PositionVertex::position, attribute_semantic::position, attribute_format::f32x3>
+        >;
+
+        static constexpr fn pack(math::vector4<core::f32> const &position,
+                                 math::vector3<core::f32> const &,
+                                 math::vector3<core::f32> const &) -> PositionVertex { return PositionVertex{math::vector3<core::f32>{position}}; }
+
+        constexpr friend fn operator==(PositionVertex const &, PositionVertex const &) -> bool = default;
+    };
+
+    constexpr fn position_of(PositionVertex const &vertex) -> math::vector3<core::f32> { return vertex.position; }
+
+    // 24 bytes, for lit shaders
+    struct PositionNormalVertex {
+        math::vector3<core::f32> position{};
+        math::vector3<core::f32> normal{};
+
+        using attributes = attribute_list<
+            attribute<&PositionNormalVertex::position, attribute_semantic::position, attribute_format::f32x3>,
+            attribute<&PositionNormalVertex::normal, attribute_semantic::normal, attribute_format::f32x3>
+        >;
+
+        static constexpr fn pack(math::vector4<core::f32> const &position,
+                                 math::vector3<core::f32> const &,
+                                 math::vector3<core::f32> const &normal) -> PositionNormalVertex {
+            return PositionNormalVertex{math::vector3<core::f32>{position}, normal};
+        }
+
+        constexpr friend fn operator==(PositionNormalVertex const &, PositionNormalVertex const &) -> bool = default;
+    };
+
+    constexpr fn position_of(PositionNormalVertex const &vertex) -> math::vector3<core::f32> { return vertex.position; }
+
+    // 8 bytes, half-float positions keep 11 significant bits, about 0.05% of the coordinate's magnitude
+    struct PackedPositionVertex {
+        std::array<core::u16, 4> position{};
+
+        using attributes = attribute_list<
+            attribute<&PackedPositionVertex::position, attribute_semantic::position, attribute_format::f16x4>
+        >;
+
+        static constexpr fn pack(math::vector4<core::f32> const &position,
+                                 math::vector3<core::f32> const &,
+                                 math::vector3<core::f32> const &) -> PackedPositionVertex { return PackedPositionVertex{pack_half4(position)}; }
+
+        constexpr friend fn operator==(PackedPositionVertex const &, PackedPositionVertex const &) -> bool = default;
+    };
+
+    constexpr fn position_of(PackedPositionVertex const &vertex) -> math::vector3<core::f32> {
+        return math::vector3<core::f32>{unpack_half(vertex.position[0]), unpack_half(vertex.position[1]), unpack_half(vertex.position[2])};
+    }
+
+    // 16 bytes, half-float position, 10:10:10:2 normal and 16-bit uv, against at least 52 for Vertex
+    struct PackedVertex {
+        std::array<core::u16, 4> position{};
+        std::uint32_t            normal = 0;
+        std::array<core::u16, 2> uv{};
+
+        using attributes = attribute_list<
+            attribute<&PackedVertex::position, attribute_semantic::position, attribute_format::f16x4>,
+            attribute<&PackedVertex::normal, attribute_semantic::normal, attribute_format::snorm10x3>,
+            attribute<&PackedVertex::uv, attribute_semantic::uv, attribute_format::unorm16x2>
+        >;
+
+        static fn pack(math::vector4<core::f32> const &position,
+                       math::vector3<core::f32> const &uv,
+                       math::vector3<core::f32> const &normal) -> PackedVertex {
+            return PackedVertex{pack_half4(position), pack_snorm10x3(normal), pack_unorm16x2(uv.s, uv.t)};
+        }
+
+        constexpr friend fn operator==(PackedVertex const &, PackedVertex const &) -> bool = default;
+    };
+
+    constexpr fn position_of(PackedVertex const &vertex) -> math::vector3<core::f32> {
+        return math::vector3<core::f32>{unpack_half(vertex.position[0]), unpack_half(vertex.position[1]), unpack_half(vertex.position[2])};
+    }
+
+    // a layout the loader can pack into and Model::layout can bind
+    template<typename V>
+    concept vertex_layout = requires(math::vector4<core::f32> const &position, math::vector3<core::f32> const &attribute, V const &vertex) {
+        typename V::attributes;
+        { V::pack(position, attribute, attribute) } -> std::same_as<V>;
+        { position_of(vertex) } -> std::same_as<math::vector3<core::f32>>;
+    };
 }
 
 #endif //MICRO_GRAPHICS_VERTEX_H
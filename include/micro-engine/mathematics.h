@@ -5,6 +5,12 @@
 #ifndef MICRO_MATHEMATICS_H
 #define MICRO_MATHEMATICS_H
 
+#include "mathematics/average.h"
+#include "mathematics/dispatch.h"
+#include "mathematics/euler.h"
 #include "mathematics/linear.h"
+#include "mathematics/quaternion-tree.h"
+#include "mathematics/simd.h"
+#include "mathematics/soa.h"
 
 #endif //MICRO_MATHEMATICS_H
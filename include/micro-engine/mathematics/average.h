@@ -0,0 +1,252 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+#ifndef MICRO_MATHEMATICS_AVERAGE_H
+#define MICRO_MATHEMATICS_AVERAGE_H
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "linear.h"
+#include "simd.h"
+#include "../core/types.h"
+
+namespace micro::math {
+    namespace internal {
+        // sum of w * q * q^T over unit quaternions laid out as (s, x, y, z)
+        template<floating_point T>
+        struct quaternion_outer_product_sum {
+            static fn compute(quaternion<T> const *quats, T const *weights, core::usize count) -> matrix<4, 4, T> {
+                matrix<4, 4, T> acc{static_cast<T>(0)};
+                for (core::usize i = 0; i < count; ++i) {
+                    auto const &q = quats[i];
+                    auto const  w = weights != nullptr ? weights[i] : static_cast<T>(1);
+
+                    vector<4, T> v{q.s, q.x, q.y, q.z};
+                    acc[0] += v * (w * q.s);
+                    acc[1] += v * (w * q.x);
+                    acc[2] += v * (w * q.y);
+                    acc[3] += v * (w * q.z);
+                }
+                return acc;
+            }
+        };
+
+#ifdef MICRO_MATHEMATICS_SSE
+        template<>
+        struct quaternion_outer_product_sum<float> {
+            static fn compute(quaternion<float> const *quats, float const *weights, core::usize count) -> matrix<4, 4, float> {
+                auto c0 = _mm_setzero_ps();
+                auto c1 = _mm_setzero_ps();
+                auto c2 = _mm_setzero_ps();
+                auto c3 = _mm_setzero_ps();
+                for (core::usize i = 0; i < count; ++i) {
+                    auto const v  = _mm_loadu_ps(&quats[i].s);
+                    auto const wv = weights != nullptr ? _mm_mul_ps(v, _mm_set1_ps(weights[i])) : v;
+
+                    c0 = _mm_add_ps(c0, _mm_mul_ps(v, _mm_shuffle_ps(wv, wv, _MM_SHUFFLE(0, 0, 0, 0))));
+                    c1 = _mm_add_ps(c1, _mm_mul_ps(v, _mm_shuffle_ps(wv, wv, _MM_SHUFFLE(1, 1, 1, 1))));
+                    c2 = _mm_add_ps(c2, _mm_mul_ps(v, _mm_shuffle_ps(wv, wv, _MM_SHUFFLE(2, 2, 2, 2))));
+                    c3 = _mm_add_ps(c3, _mm_mul_ps(v, _mm_shuffle_ps(wv, wv, _MM_SHUFFLE(3, 3, 3, 3))));
+                }
+
+                matrix<4, 4, float> acc{};
+                _mm_storeu_ps(&acc[0].x, c0);
+                _mm_storeu_ps(&acc[1].x, c1);
+                _mm_storeu_ps(&acc[2].x, c2);
+                _mm_storeu_ps(&acc[3].x, c3);
+                return acc;
+            }
+        };
+#endif
+
+        // splits the range into one chunk per thread and sums the partial outer products
+        template<floating_point T>
+        fn parallel_outer_product_sum(quaternion<T> const *quats,
+                                      T const *            weights,
+                                      core::usize          count,
+                                      core::usize          threads) -> matrix<4, 4, T> {
+            constexpr core::usize min_chunk = 1 << 14;
+
+            if (threads == 0)
+                threads = std::min<core::usize>(std::max(std::thread::hardware_concurrency(), 1u),
+                                                std::max<core::usize>(count / min_chunk, 1));
+            if (threads <= 1)
+                return quaternion_outer_product_sum<T>::compute(quats, weights, count);
+
+            auto const chunk = (count + threads - 1) / threads;
+
+            std::vector<matrix<4, 4, T>> partials(threads, matrix<4, 4, T>{static_cast<T>(0)});
+            std::vector<std::thread>     workers{};
+            workers.reserve(threads);
+            for (core::usize t = 0; t < threads; ++t) {
+                auto const begin = std::min(t * chunk, count);
+                auto const size  = std::min(chunk, count - begin);
+                workers.emplace_back(
+                    [&, t, begin, size]() {
+                        partials[t] = quaternion_outer_product_sum<T>::compute(
+                            quats + begin,
+                            weights != nullptr ? weights + begin : nullptr,
+                            size
+                        );
+                    }
+                );
+            }
+            for (auto &worker : workers)
+                worker.join();
+
+            matrix<4, 4, T> acc{static_cast<T>(0)};
+            for (auto const &partial : partials)
+                acc += partial;
+            return acc;
+        }
+
+        // cyclic Jacobi sweeps over a symmetric 4x4, returns the eigenvector of the largest eigenvalue
+        template<floating_point T>
+        fn principal_eigenvector(matrix<4, 4, T> const &mat) -> vector<4, T> {
+            T a[4][4];
+            T v[4][4];
+            for (core::usize i = 0; i < 4; ++i)
+                for (core::usize j = 0; j < 4; ++j) {
+                    a[i][j] = mat[j][i];
+                    v[i][j] = i == j ? static_cast<T>(1) : static_cast<T>(0);
+                }
+
+            for (auto sweep = 0; sweep < 32; ++sweep) {
+                auto offDiagonal = static_cast<T>(0);
+                auto diagonal    = static_cast<T>(0);
+                for (core::usize i = 0; i < 4; ++i) {
+                    diagonal += a[i][i] * a[i][i];
+                    for (core::usize j = i + 1; j < 4; ++j)
+                        offDiagonal += a[i][j] * a[i][j];
+                }
+                if (offDiagonal <= std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon() * diagonal)
+                    break;
+
+                for (core::usize p = 0; p < 3; ++p)
+                    for (core::usize q = p + 1; q < 4; ++q) {
+                        if (a[p][q] == static_cast<T>(0))
+                            continue;
+
+                        auto const theta = (a[q][q] - a[p][p]) / (static_cast<T>(2) * a[p][q]);
+                        auto const t     = (theta < static_cast<T>(0) ? static_cast<T>(-1) : static_cast<T>(1)) /
+                                           (abs(theta) + sqrt(theta * theta + static_cast<T>(1)));
+                        auto const c = static_cast<T>(1) / sqrt(t * t + static_cast<T>(1));
+                        auto const s = t * c;
+
+                        for (core::usize k = 0; k < 4; ++k) {
+                            auto const akp = a[k][p];
+                            auto const akq = a[k][q];
+                            a[k][p] = c * akp - s * akq;
+                            a[k][q] = s * akp + c * akq;
+                        }
+                        for (core::usize k = 0; k < 4; ++k) {
+                            auto const apk = a[p][k];
+                            auto const aqk = a[q][k];
+                            a[p][k] = c * apk - s * aqk;
+                            a[q][k] = s * apk + c * aqk;
+                        }
+                        for (core::usize k = 0; k < 4; ++k) {
+                            auto const vkp = v[k][p];
+                            auto const vkq = v[k][q];
+                            v[k][p] = c * vkp - s * vkq;
+                            v[k][q] = s * vkp + c * vkq;
+                        }
+                    }
+            }
+
+            core::usize principal = 0;
+            for (core::usize i = 1; i < 4; ++i)
+                if (a[i][i] > a[principal][principal])
+                    principal = i;
+
+            return {v[0][principal], v[1][principal], v[2][principal], v[3][principal]};
+        }
+
+        template<floating_point T>
+        fn quaternion_from_outer_product_sum(matrix<4, 4, T> const &sum) -> quaternion<T> {
+            auto const e    = principal_eigenvector(sum);
+            auto const quat = normalize(quaternion<T>{e.x, e.y, e.z, e.w});
+            return quat.s < static_cast<T>(0) ? -quat : quat;
+        }
+    }
+
+    // Markley et al. average of unit quaternions, the principal eigenvector of sum(q * q^T),
+    // threads == 0 picks a thread count from the input size
+    template<floating_point T>
+    fn average(quaternion<T> const *quats, core::usize count, core::usize threads = 0) -> quaternion<T> {
+        if (count == 0)
+            return quaternion<T>::real(static_cast<T>(1));
+
+        return internal::quaternion_from_outer_product_sum(
+            internal::parallel_outer_product_sum<T>(quats, nullptr, count, threads));
+    }
+
+    template<floating_point T>
+    fn average(std::vector<quaternion<T>> const &quats, core::usize threads = 0) -> quaternion<T> { return average(quats.data(), quats.size(), threads); }
+
+    template<floating_point T>
+    fn weighted_average(quaternion<T> const *quats,
+                        T const *            weights,
+                        core::usize          count,
+                        core::usize          threads = 0) -> quaternion<T> {
+        if (count == 0)
+            return quaternion<T>::real(static_cast<T>(1));
+
+        return internal::quaternion_from_outer_product_sum(
+            internal::parallel_outer_product_sum<T>(quats, weights, count, threads));
+    }
+
+    template<floating_point T>
+    fn weighted_average(std::vector<quaternion<T>> const &quats,
+                        std::vector<T> const &            weights,
+                        core::usize                       threads = 0) -> quaternion<T> {
+        assert(quats.size() == weights.size());
+        return weighted_average(quats.data(), weights.data(), quats.size(), threads);
+    }
+
+    // streaming variant, O(1) per added or removed rotation, the mean is solved on demand
+    template<floating_point T>
+    class quaternion_accumulator {
+    public:
+        using value_type = T;
+
+        fn add(quaternion<T> const &quat, T weight = static_cast<T>(1)) -> void {
+            sum += internal::quaternion_outer_product_sum<T>::compute(&quat, &weight, 1);
+            total += weight;
+            ++count_;
+        }
+
+        fn remove(quaternion<T> const &quat, T weight = static_cast<T>(1)) -> void {
+            sum -= internal::quaternion_outer_product_sum<T>::compute(&quat, &weight, 1);
+            total -= weight;
+            --count_;
+        }
+
+        fn reset() -> void {
+            sum    = matrix<4, 4, T>{static_cast<T>(0)};
+            total  = static_cast<T>(0);
+            count_ = 0;
+        }
+
+        [[nodiscard]] fn count() const -> core::usize { return count_; }
+
+        [[nodiscard]] fn weight() const -> T { return total; }
+
+        [[nodiscard]] fn mean() const -> quaternion<T> {
+            if (count_ == 0)
+                return quaternion<T>::real(static_cast<T>(1));
+
+            return internal::quaternion_from_outer_product_sum(sum);
+        }
+
+    private:
+        matrix<4, 4, T> sum{static_cast<T>(0)};
+        T               total  = static_cast<T>(0);
+        core::usize     count_ = 0;
+    };
+}
+
+#endif //MICRO_MATHEMATICS_AVERAGE_H
@@ -0,0 +1,582 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+#ifndef MICRO_MATHEMATICS_DISPATCH_H
+#define MICRO_MATHEMATICS_DISPATCH_H
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "linear.h"
+#include "simd.h"
+#include "soa.h"
+#include "../core/types.h"
+#include "../performance/affinity.h"
+#include "../performance/cpu.h"
+#include "../performance/suite.h"
+
+// function multiversioning, every kernel body is compiled once per instruction set into its own function and the one
+// to run is picked at runtime, flatten inlines the whole body (linear.h operators included) so all of it is compiled
+// for the wider target
+#if defined(MICRO_MATHEMATICS_SSE) && (defined(__GNUC__) || defined(__clang__))
+#define MICRO_MATHEMATICS_MULTIVERSION
+#define MICRO_MATHEMATICS_TARGET_AVX2 __attribute__((target("avx2,fma"), flatten))
+#define MICRO_MATHEMATICS_TARGET_AVX512 __attribute__((target("avx512f,avx512vl,avx2,fma"), flatten))
+#endif
+
+// the scalar variants must not be auto-vectorized, or they would only measure the baseline instruction set twice
+#if defined(__clang__)
+#define MICRO_MATHEMATICS_TARGET_SCALAR
+#define MICRO_MATHEMATICS_NO_VECTORIZE _Pragma("clang loop vectorize(disable) interleave(disable)")
+#elif defined(__GNUC__)
+#define MICRO_MATHEMATICS_TARGET_SCALAR __attribute__((optimize("no-tree-vectorize")))
+#define MICRO_MATHEMATICS_NO_VECTORIZE
+#else
+#define MICRO_MATHEMATICS_TARGET_SCALAR
+#define MICRO_MATHEMATICS_NO_VECTORIZE
+#endif
+
+namespace micro::math {
+    enum class kernel_variant : core::u8 {
+        scalar,
+        sse,
+        avx2,
+        avx512,
+        threaded
+    };
+
+    inline constexpr core::usize kernel_variant_count = 5;
+
+    inline constexpr kernel_variant kernel_variants[]{
+        kernel_variant::scalar, kernel_variant::sse, kernel_variant::avx2, kernel_variant::avx512, kernel_variant::threaded
+    };
+
+    constexpr fn name(kernel_variant variant) -> core::cstring {
+        switch (variant) {
+            default:
+            case kernel_variant::scalar: return "scalar";
+            case kernel_variant::sse: return "sse";
+            case kernel_variant::avx2: return "avx2";
+            case kernel_variant::avx512: return "avx512";
+            case kernel_variant::threaded: return "threaded";
+        }
+    }
+
+    // whether the variant can run on this cpu, the threaded one needs more than one hardware thread
+    fn supported(kernel_variant variant) -> bool {
+        switch (variant) {
+            default:
+            case kernel_variant::scalar:
+                return true;
+#ifdef MICRO_MATHEMATICS_SSE
+            case kernel_variant::sse:
+                return true;
+#endif
+#ifdef MICRO_MATHEMATICS_MULTIVERSION
+            case kernel_variant::avx2:
+                return perf::cpu().avx2 && perf::cpu().fma;
+            case kernel_variant::avx512:
+                return perf::cpu().avx512f && perf::cpu().avx512vl;
+#endif
+            case kernel_variant::threaded:
+                return perf::concurrency() > 1;
+        }
+        return false;
+    }
+
+    // the widest single-threaded variant this cpu supports
+    fn widest() -> kernel_variant {
+        for (auto const variant : {kernel_variant::avx512, kernel_variant::avx2, kernel_variant::sse})
+            if (supported(variant))
+                return variant;
+        return kernel_variant::scalar;
+    }
+
+    enum class kernel : core::u8 {
+        compose_quaternion,
+        compose_matrix,
+        bounds,
+        transform
+    };
+
+    inline constexpr core::usize kernel_count = 4;
+
+    inline constexpr kernel kernels_all[]{
+        kernel::compose_quaternion, kernel::compose_matrix, kernel::bounds, kernel::transform
+    };
+
+    constexpr fn name(kernel k) -> core::cstring {
+        switch (k) {
+            default:
+            case kernel::compose_quaternion: return "quaternion composition";
+            case kernel::compose_matrix: return "matrix composition";
+            case kernel::bounds: return "bounding box";
+            case kernel::transform: return "batch transform";
+        }
+    }
+
+    struct kernel_selection {
+        std::array<kernel_variant, kernel_count> variants{};
+
+        constexpr fn operator[](kernel k) -> kernel_variant & { return variants[static_cast<core::usize>(k)]; }
+
+        constexpr fn operator[](kernel k) const -> kernel_variant const & { return variants[static_cast<core::usize>(k)]; }
+    };
+
+    // the variant every call without an explicit one uses, starts at the widest supported instruction set
+    fn kernels() -> kernel_selection & {
+        static kernel_selection selection = []() {
+            kernel_selection res{};
+            res.variants.fill(widest());
+            return res;
+        }();
+        return selection;
+    }
+
+    namespace internal {
+        // ordered product p[count - 1] * ... * p[0], cut into Chains contiguous segments multiplied in lockstep so the
+        // independent chains hide the latency of each product and fill the vector lanes, the segment products are then
+        // combined in order, composition is associative but not commutative
+        template<core::usize Chains>
+        [[gnu::always_inline]] inline fn compose_body(quaternion<core::f32> const *quats, core::usize count) -> quaternion<core::f32> {
+            auto const length = Chains > 1 ? count / Chains : 0;
+
+            std::array<core::f32, Chains> s{}, x{}, y{}, z{};
+            s.fill(1.f);
+
+            for (core::usize j = 0; j < length; ++j)
+                for (core::usize k = 0; k < Chains; ++k) {
+                    auto const &q  = quats[k * length + j];
+                    auto const  ns = q.s * s[k] - q.x * x[k] - q.y * y[k] - q.z * z[k];
+                    auto const  nx = q.s * x[k] + q.x * s[k] + q.y * z[k] - q.z * y[k];
+                    auto const  ny = q.s * y[k] + q.y * s[k] + q.z * x[k] - q.x * z[k];
+                    auto const  nz = q.s * z[k] + q.z * s[k] + q.x * y[k] - q.y * x[k];
+                    s[k] = ns;
+                    x[k] = nx;
+                    y[k] = ny;
+                    z[k] = nz;
+                }
+
+            auto acc = quaternion<core::f32>::real(1.f);
+            for (core::usize k = 0; k < Chains && length > 0; ++k)
+                acc = quaternion<core::f32>{s[k], x[k], y[k], z[k]} * acc;
+            for (auto i = Chains * length; i < count; ++i)
+                acc = quats[i] * acc;
+            return acc;
+        }
+
+        template<core::usize Chains>
+        [[gnu::always_inline]] inline fn compose_body(matrix<3, 3, core::f32> const *mats, core::usize count) -> matrix<3, 3, core::f32> {
+            auto const length = Chains > 1 ? count / Chains : 0;
+
+            // a 3x3 product is too narrow to spread over lanes and the elements would have to be gathered, the chains
+            // are independent products the core overlaps instead, the autotuner keeps the single chain where that loses
+            std::array<matrix<3, 3, core::f32>, Chains> acc{};
+            acc.fill(matrix<3, 3, core::f32>::identity());
+
+            for (core::usize j = 0; j < length; ++j)
+                for (core::usize k = 0; k < Chains; ++k)
+                    acc[k] = mats[k * length + j] * acc[k];
+
+            auto res = matrix<3, 3, core::f32>::identity();
+            for (core::usize k = 0; k < Chains && length > 0; ++k)
+                res = acc[k] * res;
+            for (auto i = Chains * length; i < count; ++i)
+                res = mats[i] * res;
+            return res;
+        }
+
+        // min and max of one lane, Width independent accumulators make the loop element-wise instead of a reduction,
+        // which the compiler vectorizes without relaxing floating point semantics
+        template<core::usize Width>
+        [[gnu::always_inline]] inline fn bounds_body(core::f32 const *values, core::usize count) -> std::pair<core::f32, core::f32> {
+            std::array<core::f32, Width> lo{}, hi{};
+            lo.fill(std::numeric_limits<core::f32>::max());
+            hi.fill(std::numeric_limits<core::f32>::lowest());
+
+            core::usize i = 0;
+            for (; i + Width <= count; i += Width)
+                for (core::usize k = 0; k < Width; ++k) {
+                    lo[k] = values[i + k] < lo[k] ? values[i + k] : lo[k];
+                    hi[k] = values[i + k] > hi[k] ? values[i + k] : hi[k];
+                }
+
+            auto resLo = std::numeric_limits<core::f32>::max();
+            auto resHi = std::numeric_limits<core::f32>::lowest();
+            for (core::usize k = 0; k < Width; ++k) {
+                resLo = min(resLo, lo[k]);
+                resHi = max(resHi, hi[k]);
+            }
+            for (; i < count; ++i) {
+                resLo = min(resLo, values[i]);
+                resHi = max(resHi, values[i]);
+            }
+            return {resLo, resHi};
+        }
+
+        using compose_quaternion_kernel = quaternion<core::f32> (*)(quaternion<core::f32> const *, core::usize);
+        using compose_matrix_kernel = matrix<3, 3, core::f32> (*)(matrix<3, 3, core::f32> const *, core::usize);
+        using bounds_kernel = std::pair<core::f32, core::f32> (*)(core::f32 const *, core::usize);
+        // the operand is a matrix4x4 (affine point transform), a matrix3x3 or a unit quaternion (sandwich product)
+        template<typename Operand>
+        using transform_kernel = void (*)(core::f32 const *, core::f32 const *, core::f32 const *,
+                                          core::f32 *, core::f32 *, core::f32 *, core::usize, Operand const &);
+
+        fn transform_point(matrix<4, 4, core::f32> const &mat, vector<3, core::f32> const &p) -> vector<3, core::f32> { return vector<3, core::f32>{mat * vector<4, core::f32>{p, 1.f}}; }
+
+        fn transform_point(matrix<3, 3, core::f32> const &mat, vector<3, core::f32> const &p) -> vector<3, core::f32> { return mat * p; }
+
+        fn transform_point(quaternion<core::f32> const &quat, vector<3, core::f32> const &p) -> vector<3, core::f32> { return quat * p; }
+
+        MICRO_MATHEMATICS_TARGET_SCALAR
+        fn compose_scalar(quaternion<core::f32> const *quats, core::usize count) -> quaternion<core::f32> { return compose_body<1>(quats, count); }
+
+        MICRO_MATHEMATICS_TARGET_SCALAR
+        fn compose_scalar(matrix<3, 3, core::f32> const *mats, core::usize count) -> matrix<3, 3, core::f32> { return compose_body<1>(mats, count); }
+
+        MICRO_MATHEMATICS_TARGET_SCALAR
+        fn bounds_scalar(core::f32 const *values, core::usize count) -> std::pair<core::f32, core::f32> {
+            auto lo = std::numeric_limits<core::f32>::max();
+            auto hi = std::numeric_limits<core::f32>::lowest();
+            MICRO_MATHEMATICS_NO_VECTORIZE
+            for (core::usize i = 0; i < count; ++i) {
+                lo = min(lo, values[i]);
+                hi = max(hi, values[i]);
+            }
+            return {lo, hi};
+        }
+
+        template<typename Operand>
+        MICRO_MATHEMATICS_TARGET_SCALAR
+        fn transform_scalar(core::f32 const *x, core::f32 const *y, core::f32 const *z,
+                            core::f32 *ox, core::f32 *oy, core::f32 *oz, core::usize count, Operand const &op) -> void {
+            MICRO_MATHEMATICS_NO_VECTORIZE
+            for (core::usize i = 0; i < count; ++i) {
+                auto const p = transform_point(op, vector<3, core::f32>{x[i], y[i], z[i]});
+                ox[i] = p.x;
+                oy[i] = p.y;
+                oz[i] = p.z;
+            }
+        }
+
+#ifdef MICRO_MATHEMATICS_SSE
+        fn compose_sse(quaternion<core::f32> const *quats, core::usize count) -> quaternion<core::f32> { return compose_body<8>(quats, count); }
+
+        fn compose_sse(matrix<3, 3, core::f32> const *mats, core::usize count) -> matrix<3, 3, core::f32> { return compose_body<4>(mats, count); }
+
+        fn bounds_sse(core::f32 const *values, core::usize count) -> std::pair<core::f32, core::f32> { return bounds_body<8>(values, count); }
+
+        template<typename Operand>
+        fn transform_sse(core::f32 const *x, core::f32 const *y, core::f32 const *z,
+                         core::f32 *ox, core::f32 *oy, core::f32 *oz, core::usize count, Operand const &op) -> void {
+            soa_transform<core::f32>(x, y, z, ox, oy, oz, count, op);
+        }
+#endif
+
+#ifdef MICRO_MATHEMATICS_MULTIVERSION
+        MICRO_MATHEMATICS_TARGET_AVX2
+        fn compose_avx2(quaternion<core::f32> const *quats, core::usize count) -> quaternion<core::f32> { return compose_body<8>(quats, count); }
+
+        MICRO_MATHEMATICS_TARGET_AVX2
+        fn compose_avx2(matrix<3, 3, core::f32> const *mats, core::usize count) -> matrix<3, 3, core::f32> { return compose_body<4>(mats, count); }
+
+        MICRO_MATHEMATICS_TARGET_AVX2
+        fn bounds_avx2(core::f32 const *values, core::usize count) -> std::pair<core::f32, core::f32> { return bounds_body<16>(values, count); }
+
+        template<typename Operand>
+        MICRO_MATHEMATICS_TARGET_AVX2
+        fn transform_avx2(core::f32 const *x, core::f32 const *y, core::f32 const *z,
+                          core::f32 *ox, core::f32 *oy, core::f32 *oz, core::usize count, Operand const &op) -> void {
+            soa_transform<core::f32>(x, y, z, ox, oy, oz, count, op);
+        }
+
+        MICRO_MATHEMATICS_TARGET_AVX512
+        fn compose_avx512(quaternion<core::f32> const *quats, core::usize count) -> quaternion<core::f32> { return compose_body<16>(quats, count); }
+
+        MICRO_MATHEMATICS_TARGET_AVX512
+        fn compose_avx512(matrix<3, 3, core::f32> const *mats, core::usize count) -> matrix<3, 3, core::f32> { return compose_body<4>(mats, count); }
+
+        MICRO_MATHEMATICS_TARGET_AVX512
+        fn bounds_avx512(core::f32 const *values, core::usize count) -> std::pair<core::f32, core::f32> { return bounds_body<32>(values, count); }
+
+        template<typename Operand>
+        MICRO_MATHEMATICS_TARGET_AVX512
+        fn transform_avx512(core::f32 const *x, core::f32 const *y, core::f32 const *z,
+                            core::f32 *ox, core::f32 *oy, core::f32 *oz, core::usize count, Operand const &op) -> void {
+            soa_transform<core::f32>(x, y, z, ox, oy, oz, count, op);
+        }
+#endif
+
+        // single-threaded kernel of a variant, the threaded variant runs the widest one on every thread, unsupported
+        // variants fall back to the widest supported one
+        template<typename Kernel>
+        fn select(kernel_variant variant, Kernel scalar, Kernel sse, Kernel avx2, Kernel avx512) -> Kernel {
+            if (variant == kernel_variant::threaded || !supported(variant))
+                variant = widest();
+
+            switch (variant) {
+                default:
+                case kernel_variant::scalar: return scalar;
+                case kernel_variant::sse: return sse != nullptr ? sse : scalar;
+                case kernel_variant::avx2: return avx2 != nullptr ? avx2 : scalar;
+                case kernel_variant::avx512: return avx512 != nullptr ? avx512 : scalar;
+            }
+        }
+
+#ifdef MICRO_MATHEMATICS_SSE
+#define MICRO_MATHEMATICS_KERNEL_SSE(name, type) static_cast<type>(name)
+#else
+#define MICRO_MATHEMATICS_KERNEL_SSE(name, type) static_cast<type>(nullptr)
+#endif
+#ifdef MICRO_MATHEMATICS_MULTIVERSION
+#define MICRO_MATHEMATICS_KERNEL_AVX(name, type) static_cast<type>(name)
+#else
+#define MICRO_MATHEMATICS_KERNEL_AVX(name, type) static_cast<type>(nullptr)
+#endif
+
+        fn select_compose_quaternion(kernel_variant variant) -> compose_quaternion_kernel {
+            return select<compose_quaternion_kernel>(
+                variant,
+                static_cast<compose_quaternion_kernel>(compose_scalar),
+                MICRO_MATHEMATICS_KERNEL_SSE(compose_sse, compose_quaternion_kernel),
+                MICRO_MATHEMATICS_KERNEL_AVX(compose_avx2, compose_quaternion_kernel),
+                MICRO_MATHEMATICS_KERNEL_AVX(compose_avx512, compose_quaternion_kernel)
+            );
+        }
+
+        fn select_compose_matrix(kernel_variant variant) -> compose_matrix_kernel {
+            return select<compose_matrix_kernel>(
+                variant,
+                static_cast<compose_matrix_kernel>(compose_scalar),
+                MICRO_MATHEMATICS_KERNEL_SSE(compose_sse, compose_matrix_kernel),
+                MICRO_MATHEMATICS_KERNEL_AVX(compose_avx2, compose_matrix_kernel),
+                MICRO_MATHEMATICS_KERNEL_AVX(compose_avx512, compose_matrix_kernel)
+            );
+        }
+
+        fn select_bounds(kernel_variant variant) -> bounds_kernel {
+            return select<bounds_kernel>(
+                variant,
+                bounds_scalar,
+                MICRO_MATHEMATICS_KERNEL_SSE(bounds_sse, bounds_kernel),
+                MICRO_MATHEMATICS_KERNEL_AVX(bounds_avx2, bounds_kernel),
+                MICRO_MATHEMATICS_KERNEL_AVX(bounds_avx512, bounds_kernel)
+            );
+        }
+
+        template<typename Operand>
+        fn select_transform(kernel_variant variant) -> transform_kernel<Operand> {
+            return select<transform_kernel<Operand>>(
+                variant,
+                transform_scalar<Operand>,
+                MICRO_MATHEMATICS_KERNEL_SSE(transform_sse<Operand>, transform_kernel<Operand>),
+                MICRO_MATHEMATICS_KERNEL_AVX(transform_avx2<Operand>, transform_kernel<Operand>),
+                MICRO_MATHEMATICS_KERNEL_AVX(transform_avx512<Operand>, transform_kernel<Operand>)
+            );
+        }
+
+#undef MICRO_MATHEMATICS_KERNEL_SSE
+#undef MICRO_MATHEMATICS_KERNEL_AVX
+
+        // splits [0, count) into one contiguous range per hardware thread, each at least minimum long, runs
+        // work(index, first, size) for every range (the first on the calling thread) and returns the number of ranges
+        template<typename Work>
+        fn parallel_ranges(core::usize count, core::usize minimum, Work &&work) -> core::usize {
+            auto const threads = max(core::usize{1}, min(perf::concurrency(), count / max(minimum, core::usize{1})));
+            auto const size    = (count + threads - 1) / threads;
+
+            std::vector<std::thread> workers{};
+            workers.reserve(threads - 1);
+            for (core::usize t = 1; t < threads; ++t)
+                workers.emplace_back([&, t]() { work(t, t * size, min(size, count - min(count, t * size))); });
+            work(0, 0, min(size, count));
+
+            for (auto &worker : workers)
+                worker.join();
+            return threads;
+        }
+
+        // below this many elements per thread spawning threads costs more than it saves
+        inline constexpr core::usize parallel_minimum = 16'384;
+
+        template<typename T, typename Kernel>
+        fn compose_threaded(T const *values, core::usize count, Kernel kernel, T identity) -> T {
+            std::vector<T> partial(perf::concurrency(), identity);
+            auto const     ranges = parallel_ranges(count, parallel_minimum, [&](core::usize t, core::usize first, core::usize size) {
+                partial[t] = kernel(values + first, size);
+            });
+
+            auto res = identity;
+            for (core::usize t = 0; t < ranges; ++t)
+                res = partial[t] * res;
+            return res;
+        }
+    }
+
+    // ordered product quats[count - 1] * ... * quats[0], i.e. quats[0] is applied first
+    fn compose(quaternion<core::f32> const *quats, core::usize count, kernel_variant variant) -> quaternion<core::f32> {
+        auto const kernel = internal::select_compose_quaternion(variant);
+        return variant == kernel_variant::threaded && supported(variant)
+                   ? internal::compose_threaded(quats, count, kernel, quaternion<core::f32>::real(1.f))
+                   : kernel(quats, count);
+    }
+
+    fn compose(quaternion<core::f32> const *quats, core::usize count) -> quaternion<core::f32> { return compose(quats, count, kernels()[kernel::compose_quaternion]); }
+
+    // ordered product mats[count - 1] * ... * mats[0], i.e. mats[0] is applied first
+    fn compose(matrix<3, 3, core::f32> const *mats, core::usize count, kernel_variant variant) -> matrix<3, 3, core::f32> {
+        auto const kernel = internal::select_compose_matrix(variant);
+        return variant == kernel_variant::threaded && supported(variant)
+                   ? internal::compose_threaded(mats, count, kernel, matrix<3, 3, core::f32>::identity())
+                   : kernel(mats, count);
+    }
+
+    fn compose(matrix<3, 3, core::f32> const *mats, core::usize count) -> matrix<3, 3, core::f32> { return compose(mats, count, kernels()[kernel::compose_matrix]); }
+
+    fn bounds(soa_vector3<core::f32> const &array, kernel_variant variant) -> std::pair<vector<3, core::f32>, vector<3, core::f32>> {
+        auto const kernel = internal::select_bounds(variant);
+
+        vector<3, core::f32> lo{std::numeric_limits<core::f32>::max()};
+        vector<3, core::f32> hi{std::numeric_limits<core::f32>::lowest()};
+        for (core::usize l = 0; l < 3; ++l) {
+            auto const *values = array.lane(l);
+            if (variant != kernel_variant::threaded || !supported(variant)) {
+                std::tie(lo[l], hi[l]) = kernel(values, array.size());
+                continue;
+            }
+
+            std::vector<std::pair<core::f32, core::f32>> partial(perf::concurrency(), {lo[l], hi[l]});
+            internal::parallel_ranges(array.size(), internal::parallel_minimum, [&](core::usize t, core::usize first, core::usize size) {
+                partial[t] = kernel(values + first, size);
+            });
+            for (auto const &[min_, max_] : partial) {
+                lo[l] = min(lo[l], min_);
+                hi[l] = max(hi[l], max_);
+            }
+        }
+        return {lo, hi};
+    }
+
+    fn bounds(soa_vector3<core::f32> const &array) -> std::pair<vector<3, core::f32>, vector<3, core::f32>> { return bounds(array, kernels()[kernel::bounds]); }
+
+    namespace internal {
+        // out may be the same array as in
+        template<typename Operand>
+        fn transform(soa_vector3<core::f32> const &in, Operand const &op, soa_vector3<core::f32> &out, kernel_variant variant) -> void {
+            auto const kernel  = select_transform<Operand>(variant);
+            auto const count   = in.size();
+            auto const inPlace = &in == &out;
+            if (!inPlace)
+                out.resize(count);
+
+            auto const range = [&](core::usize, core::usize first, core::usize size) {
+                if (!inPlace) {
+                    kernel(in.lane(0) + first, in.lane(1) + first, in.lane(2) + first,
+                           out.lane(0) + first, out.lane(1) + first, out.lane(2) + first, size, op);
+                    return;
+                }
+
+                // the kernels take restrict lanes, in place every block is staged first like internal::soa_apply does
+                constexpr auto block = core::usize{256};
+                alignas(soa_alignment) core::f32 staged[3][block];
+                for (core::usize offset = 0; offset < size; offset += block) {
+                    auto const n = min(block, size - offset);
+                    for (core::usize l = 0; l < 3; ++l)
+                        std::copy_n(out.lane(l) + first + offset, n, staged[l]);
+                    kernel(staged[0], staged[1], staged[2],
+                           out.lane(0) + first + offset, out.lane(1) + first + offset, out.lane(2) + first + offset, n, op);
+                }
+            };
+
+            if (variant == kernel_variant::threaded && supported(variant))
+                parallel_ranges(count, parallel_minimum, range);
+            else
+                range(0, 0, count);
+        }
+    }
+
+    // out[i] = mat * (in[i], 1), out may be the same array as in
+    fn transform(soa_vector3<core::f32> const &in, matrix<4, 4, core::f32> const &mat, soa_vector3<core::f32> &out, kernel_variant variant) -> void { internal::transform(in, mat, out, variant); }
+
+    fn transform(soa_vector3<core::f32> const &in, matrix<4, 4, core::f32> const &mat, soa_vector3<core::f32> &out) -> void { transform(in, mat, out, kernels()[kernel::transform]); }
+
+    // out[i] = mat * in[i], out may be the same array as in
+    fn transform(soa_vector3<core::f32> const &in, matrix<3, 3, core::f32> const &mat, soa_vector3<core::f32> &out, kernel_variant variant) -> void { internal::transform(in, mat, out, variant); }
+
+    fn transform(soa_vector3<core::f32> const &in, matrix<3, 3, core::f32> const &mat, soa_vector3<core::f32> &out) -> void { transform(in, mat, out, kernels()[kernel::transform]); }
+
+    // out[i] = quat * in[i] * quat^-1 evaluated per point, out may be the same array as in
+    fn sandwich(soa_vector3<core::f32> const &in, quaternion<core::f32> const &quat, soa_vector3<core::f32> &out, kernel_variant variant) -> void { internal::transform(in, normalize(quat), out, variant); }
+
+    fn sandwich(soa_vector3<core::f32> const &in, quaternion<core::f32> const &quat, soa_vector3<core::f32> &out) -> void { sandwich(in, quat, out, kernels()[kernel::transform]); }
+
+    // nanoseconds per call of every kernel and variant on the autotuned length, 0 where the variant is unsupported
+    struct autotune_result {
+        kernel_selection                                                       selection{};
+        std::array<std::array<core::f64, kernel_variant_count>, kernel_count> ns{};
+        core::usize                                                            length = 0;
+    };
+
+    // times every supported variant of every kernel on inputs of the given length, installs the fastest of each as
+    // the kernels() selection and returns the measurements, takes a few hundred milliseconds
+    fn autotune(core::usize length) -> autotune_result {
+        length = max(length, core::usize{1});
+
+        std::vector<quaternion<core::f32>>    quats(length);
+        std::vector<matrix<3, 3, core::f32>> mats(length);
+        soa_vector3<core::f32>                points{};
+        soa_vector3<core::f32>                transformed{};
+        points.resize(length);
+        for (core::usize i = 0; i < length; ++i) {
+            auto const angle = static_cast<core::f32>(i) * 0.001f;
+            quats[i] = quaternion<core::f32>::from_rotation(angle, vector<3, core::f32>{1.f, 2.f, 3.f});
+            mats[i]  = matrix<3, 3, core::f32>::from_quaternion(quats[i]);
+            points.set(i, vector<3, core::f32>{cos(angle), sin(angle), angle});
+        }
+        auto const mat = matrix<4, 4, core::f32>::from_quaternion(quats[length / 2]);
+
+        perf::suite suite{perf::suite_options{.warmup = 1, .repetitions = 5, .minRepetitionNs = 200'000.}};
+
+        autotune_result res{};
+        res.length = length;
+        for (auto const k : kernels_all) {
+            auto best = std::numeric_limits<core::f64>::max();
+            for (auto const variant : kernel_variants) {
+                if (!supported(variant))
+                    continue;
+
+                switch (k) {
+                    case kernel::compose_quaternion:
+                        suite.run(name(variant), [&](core::usize) { return compose(quats.data(), length, variant); });
+                        break;
+                    case kernel::compose_matrix:
+                        suite.run(name(variant), [&](core::usize) { return compose(mats.data(), length, variant); });
+                        break;
+                    case kernel::bounds:
+                        suite.run(name(variant), [&](core::usize) { return bounds(points, variant); });
+                        break;
+                    case kernel::transform:
+                        suite.run(name(variant), [&](core::usize) { transform(points, mat, transformed, variant); });
+                        break;
+                }
+
+                auto const ns = suite.results().back().stats.median;
+                res.ns[static_cast<core::usize>(k)][static_cast<core::usize>(variant)] = ns;
+                if (ns < best) {
+                    best           = ns;
+                    res.selection[k] = variant;
+                }
+            }
+        }
+
+        kernels() = res.selection;
+        return res;
+    }
+}
+
+#endif //MICRO_MATHEMATICS_DISPATCH_H
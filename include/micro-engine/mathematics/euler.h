@@ -0,0 +1,265 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+#ifndef MICRO_MATHEMATICS_EULER_H
+#define MICRO_MATHEMATICS_EULER_H
+
+#include <type_traits>
+#include <vector>
+
+#include "linear.h"
+#include "soa.h"
+#include "../core/types.h"
+
+namespace micro::math {
+    // the 6 Tait-Bryan and 6 proper Euler orders, "abc" means R = Ra(alpha) * Rb(beta) * Rc(gamma) (intrinsic a, b', c''),
+    // angles are positional so alpha always belongs to the first axis of the order
+    enum class euler_order : core::u8 {
+        xyz,
+        xzy,
+        yxz,
+        yzx,
+        zxy,
+        zyx,
+        xyx,
+        xzx,
+        yxy,
+        yzy,
+        zxz,
+        zyz
+    };
+
+    inline constexpr euler_order euler_orders[]{
+        euler_order::xyz, euler_order::xzy, euler_order::yxz, euler_order::yzx, euler_order::zxy, euler_order::zyx,
+        euler_order::xyx, euler_order::xzx, euler_order::yxy, euler_order::yzy, euler_order::zxz, euler_order::zyz
+    };
+
+    constexpr fn name(euler_order order) -> core::cstring {
+        switch (order) {
+            default:
+            case euler_order::xyz: return "XYZ";
+            case euler_order::xzy: return "XZY";
+            case euler_order::yxz: return "YXZ";
+            case euler_order::yzx: return "YZX";
+            case euler_order::zxy: return "ZXY";
+            case euler_order::zyx: return "ZYX";
+            case euler_order::xyx: return "XYX";
+            case euler_order::xzx: return "XZX";
+            case euler_order::yxy: return "YXY";
+            case euler_order::yzy: return "YZY";
+            case euler_order::zxz: return "ZXZ";
+            case euler_order::zyz: return "ZYZ";
+        }
+    }
+
+    // the only runtime switch over orders, callers hoist it out of their loops and receive the order as a constant:
+    // with_euler_order(order, [&](auto o) { ... from_euler<decltype(o)::value>(...) ... })
+    template<typename F>
+    fn with_euler_order(euler_order order, F &&f) -> decltype(auto) {
+        switch (order) {
+            default:
+            case euler_order::xyz: return f(std::integral_constant<euler_order, euler_order::xyz>{});
+            case euler_order::xzy: return f(std::integral_constant<euler_order, euler_order::xzy>{});
+            case euler_order::yxz: return f(std::integral_constant<euler_order, euler_order::yxz>{});
+            case euler_order::yzx: return f(std::integral_constant<euler_order, euler_order::yzx>{});
+            case euler_order::zxy: return f(std::integral_constant<euler_order, euler_order::zxy>{});
+            case euler_order::zyx: return f(std::integral_constant<euler_order, euler_order::zyx>{});
+            case euler_order::xyx: return f(std::integral_constant<euler_order, euler_order::xyx>{});
+            case euler_order::xzx: return f(std::integral_constant<euler_order, euler_order::xzx>{});
+            case euler_order::yxy: return f(std::integral_constant<euler_order, euler_order::yxy>{});
+            case euler_order::yzy: return f(std::integral_constant<euler_order, euler_order::yzy>{});
+            case euler_order::zxz: return f(std::integral_constant<euler_order, euler_order::zxz>{});
+            case euler_order::zyz: return f(std::integral_constant<euler_order, euler_order::zyz>{});
+        }
+    }
+
+    namespace internal {
+        template<euler_order O>
+        struct euler_axes {
+            static constexpr auto index = static_cast<core::usize>(O);
+
+            static constexpr bool proper = index >= 6;
+
+            // axes of the three elementary rotations
+            static constexpr core::usize first = proper
+                                                     ? (index - 6) / 2
+                                                     : index / 2;
+            static constexpr core::usize second = proper
+                                                      ? (first + 1 + (index - 6) % 2) % 3
+                                                      : (first + 1 + index % 2) % 3;
+            static constexpr core::usize third = proper ? first : 3 - first - second;
+
+            // the axis not used by a proper order, completes first, second, other to a permutation of x, y, z
+            static constexpr core::usize other = 3 - first - second;
+
+            // +1 when (first, second, other) is a cyclic permutation of (x, y, z), relabelling axes is then a rotation,
+            // otherwise it is a reflection and every angle flips sign
+            static constexpr int parity = second == (first + 1) % 3 ? 1 : -1;
+        };
+
+        // right-multiplies by the elementary rotation about axis A, only the two columns orthogonal to A change
+        template<core::usize A, floating_point T>
+        constexpr fn euler_rotate(matrix<3, 3, T> &mat, T c, T s) -> void {
+            constexpr core::usize u = (A + 1) % 3;
+            constexpr core::usize v = (A + 2) % 3;
+
+            auto const colU = mat[u];
+            auto const colV = mat[v];
+            mat[u] = colU * c + colV * s;
+            mat[v] = colV * c - colU * s;
+        }
+
+        // right-multiplies by the elementary quaternion (c, s * e_A), q * (c, s e) = (q.s c - s q_A, c q_v + s q.s e + s q_v x e)
+        template<core::usize A, floating_point T>
+        constexpr fn euler_rotate(quaternion<T> const &q, T c, T s) -> quaternion<T> {
+            if constexpr (A == 0)
+                return {q.s * c - q.x * s, q.x * c + q.s * s, q.y * c + q.z * s, q.z * c - q.y * s};
+            else if constexpr (A == 1)
+                return {q.s * c - q.y * s, q.x * c - q.z * s, q.y * c + q.s * s, q.z * c + q.x * s};
+            else
+                return {q.s * c - q.z * s, q.x * c + q.y * s, q.y * c - q.x * s, q.z * c + q.s * s};
+        }
+
+        template<euler_order O, floating_point T>
+        struct euler_kernel {
+            using axes = euler_axes<O>;
+
+            // from the cosines and sines of the three angles
+            static constexpr fn matrix(T c0, T s0, T c1, T s1, T c2, T s2) -> math::matrix<3, 3, T> {
+                constexpr core::usize u = (axes::first + 1) % 3;
+                constexpr core::usize v = (axes::first + 2) % 3;
+
+                math::matrix<3, 3, T> mat{static_cast<T>(0)};
+                mat[axes::first][axes::first] = static_cast<T>(1);
+                mat[u][u] = c0;
+                mat[u][v] = s0;
+                mat[v][u] = -s0;
+                mat[v][v] = c0;
+
+                euler_rotate<axes::second>(mat, c1, s1);
+                euler_rotate<axes::third>(mat, c2, s2);
+                return mat;
+            }
+
+            // from the cosines and sines of the three half angles
+            static constexpr fn quaternion(T c0, T s0, T c1, T s1, T c2, T s2) -> math::quaternion<T> {
+                math::quaternion<T> quat{c0, static_cast<T>(0), static_cast<T>(0), static_cast<T>(0)};
+                quat[1 + axes::first] = s0;
+
+                return euler_rotate<axes::third>(euler_rotate<axes::second>(quat, c1, s1), c2, s2);
+            }
+
+            static fn matrix(vector<3, T> const &angles) -> math::matrix<3, 3, T> {
+                return matrix(cos(angles.x), sin(angles.x), cos(angles.y), sin(angles.y), cos(angles.z), sin(angles.z));
+            }
+
+            static fn quaternion(vector<3, T> const &angles) -> math::quaternion<T> {
+                auto const half = angles * static_cast<T>(0.5);
+                return quaternion(cos(half.x), sin(half.x), cos(half.y), sin(half.y), cos(half.z), sin(half.z));
+            }
+
+            // inverse of matrix(), the rotation is relabelled into XYZ or XYX and solved there, in gimbal lock the
+            // third angle is set to zero
+            static fn angles(math::matrix<3, 3, T> const &mat) -> vector<3, T> {
+                constexpr core::usize p[3]{axes::first, axes::second, axes::proper ? axes::other : axes::third};
+                constexpr auto        epsilon = static_cast<T>(1e-6);
+
+                // n(row, col) of the relabelled matrix, the source is column-major
+                auto const n = [&](core::usize row, core::usize col) { return mat[p[col]][p[row]]; };
+
+                vector<3, T> res{};
+                if constexpr (axes::proper) {
+                    auto const sb = sqrt(n(0, 1) * n(0, 1) + n(0, 2) * n(0, 2));
+                    res.y = atan(sb, n(0, 0));
+                    if (sb > epsilon) {
+                        res.x = atan(n(1, 0), -n(2, 0));
+                        res.z = atan(n(0, 1), n(0, 2));
+                    }
+                    else {
+                        res.x = atan(n(2, 1), n(1, 1));
+                        res.z = static_cast<T>(0);
+                    }
+                }
+                else {
+                    auto const cb = sqrt(n(0, 0) * n(0, 0) + n(0, 1) * n(0, 1));
+                    res.y = asin(clamp(n(0, 2), static_cast<T>(-1), static_cast<T>(1)));
+                    if (cb > epsilon) {
+                        res.x = atan(-n(1, 2), n(2, 2));
+                        res.z = atan(-n(0, 1), n(0, 0));
+                    }
+                    else {
+                        res.x = atan(n(2, 1), n(1, 1));
+                        res.z = static_cast<T>(0);
+                    }
+                }
+
+                return res * static_cast<T>(axes::parity);
+            }
+        };
+    }
+
+    // batch forms over structure-of-arrays angles, the trigonometry runs as its own pass over each lane and the
+    // composition is a branch-free straight-line kernel per element, so both loops vectorize independently
+    namespace internal {
+        template<floating_point T>
+        fn euler_sincos(soa_array<vector<3, T>> const &angles, T scale, std::vector<T> (&cs)[6]) -> void {
+            auto const count = angles.size();
+            for (core::usize l = 0; l < 3; ++l) {
+                cs[2 * l].resize(count);
+                cs[2 * l + 1].resize(count);
+
+                auto const *a = angles.lane(l);
+                auto *      c = cs[2 * l].data();
+                auto *      s = cs[2 * l + 1].data();
+                for (core::usize i = 0; i < count; ++i) {
+                    c[i] = cos(a[i] * scale);
+                    s[i] = sin(a[i] * scale);
+                }
+            }
+        }
+    }
+
+    template<euler_order O, floating_point T>
+    fn from_euler(soa_array<vector<3, T>> const &angles, soa_array<quaternion<T>> &out) -> void {
+        std::vector<T> cs[6];
+        internal::euler_sincos(angles, static_cast<T>(0.5), cs);
+
+        auto const count = angles.size();
+        out.resize(count);
+
+        T const *__restrict c0 = cs[0].data();
+        T const *__restrict s0 = cs[1].data();
+        T const *__restrict c1 = cs[2].data();
+        T const *__restrict s1 = cs[3].data();
+        T const *__restrict c2 = cs[4].data();
+        T const *__restrict s2 = cs[5].data();
+
+        T *__restrict os = out.lane(0);
+        T *__restrict ox = out.lane(1);
+        T *__restrict oy = out.lane(2);
+        T *__restrict oz = out.lane(3);
+
+        for (core::usize i = 0; i < count; ++i) {
+            auto const quat = internal::euler_kernel<O, T>::quaternion(c0[i], s0[i], c1[i], s1[i], c2[i], s2[i]);
+            os[i] = quat.s;
+            ox[i] = quat.x;
+            oy[i] = quat.y;
+            oz[i] = quat.z;
+        }
+    }
+
+    template<euler_order O, floating_point T>
+    fn from_euler(soa_array<vector<3, T>> const &angles, std::vector<matrix<3, 3, T>> &out) -> void {
+        std::vector<T> cs[6];
+        internal::euler_sincos(angles, static_cast<T>(1), cs);
+
+        auto const count = angles.size();
+        out.resize(count);
+
+        for (core::usize i = 0; i < count; ++i)
+            out[i] = internal::euler_kernel<O, T>::matrix(cs[0][i], cs[1][i], cs[2][i], cs[3][i], cs[4][i], cs[5][i]);
+    }
+}
+
+#endif //MICRO_MATHEMATICS_EULER_H
@@ -6,7 +6,9 @@
 #define MICRO_MATHEMATICS_LINEAR_H
 
 #include <cassert>
+#include <type_traits>
 
+#include "simd.h"
 #include "../core/types.h"
 
 namespace micro::math {
@@ -39,6 +41,18 @@ namespace micro::math {
     template<floating_point T>
     struct quaternion;
 
+    // affine transform declaration, a matrix4x4 with an implicit (0, 0, 0, 1) last row
+    template<floating_point T>
+    struct affine3x4;
+
+    // euler rotation order, defined in euler.h together with the per-order kernels
+    enum class euler_order : core::u8;
+
+    namespace internal {
+        template<euler_order O, floating_point T>
+        struct euler_kernel;
+    }
+
     namespace internal::functional {
         template<core::usize L, arithmetic R, arithmetic T>
         struct vector_functor1;
@@ -187,7 +201,13 @@ namespace micro::math {
     namespace internal {
         template<core::usize L, arithmetic T>
         struct vector_max {
-            static fn compute(vector<L, T> const &vec1, vector<L, T> const &vec2) -> vector<L, T> { return functional::vector_functor2<L, T, T>::compute(max, vec1, vec2); }
+            static fn compute(vector<L, T> const &vec1, vector<L, T> const &vec2) -> vector<L, T> {
+#ifdef MICRO_MATHEMATICS_SIMD_SSE
+                if constexpr (vector_simd<L, T>)
+                    return simd::max(vec1, vec2);
+#endif
+                return functional::vector_functor2<L, T, T>::compute(max, vec1, vec2);
+            }
         };
     }
 
@@ -197,7 +217,13 @@ namespace micro::math {
     namespace internal {
         template<core::usize L, arithmetic T>
         struct vector_min {
-            static fn compute(vector<L, T> const &vec1, vector<L, T> const &vec2) -> vector<L, T> { return functional::vector_functor2<L, T, T>::compute(min, vec1, vec2); }
+            static fn compute(vector<L, T> const &vec1, vector<L, T> const &vec2) -> vector<L, T> {
+#ifdef MICRO_MATHEMATICS_SIMD_SSE
+                if constexpr (vector_simd<L, T>)
+                    return simd::min(vec1, vec2);
+#endif
+                return functional::vector_functor2<L, T, T>::compute(min, vec1, vec2);
+            }
         };
     }
 
@@ -334,6 +360,9 @@ namespace micro::math {
     template<core::usize L, floating_point T>
     fn atan(vector<L, T> const &vec) -> vector<L, T> { return internal::vector_atan<L, T>::compute(vec); }
 
+    template<floating_point T>
+    fn atan(T y, T x) -> T { return std::atan2(y, x); }
+
     template<floating_point T>
     fn sinh(T val) -> T { return std::sinh(val); }
 
@@ -459,7 +488,14 @@ namespace micro::math {
 
         template<arithmetic T>
         struct vector_dot<4, T> {
-            static constexpr fn compute(vector<4, T> const &a, vector<4, T> const &b) -> T { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+            static constexpr fn compute(vector<4, T> const &a, vector<4, T> const &b) -> T {
+#ifdef MICRO_MATHEMATICS_SIMD_SSE
+                if constexpr (vector_simd<4, T>)
+                    if (!std::is_constant_evaluated())
+                        return simd::dot(a, b);
+#endif
+                return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+            }
         };
     }
 
@@ -492,7 +528,13 @@ namespace micro::math {
     constexpr fn cross(vector<L, T> const &x, vector<L, T> const &y) -> vector<3, T> { return internal::vector_cross<L, T>::compute(x, y); }
 
     template<core::usize L, floating_point T>
-    fn normalize(vector<L, T> const &vec) -> vector<L, T> { return vec / magnitude(vec); }
+    fn normalize(vector<L, T> const &vec) -> vector<L, T> {
+#ifdef MICRO_MATHEMATICS_SIMD_SSE
+        if constexpr (internal::vector_simd<L, T>)
+            return internal::simd::normalize(vec);
+#endif
+        return vec / magnitude(vec);
+    }
 
     template<core::usize L, arithmetic T>
     constexpr fn faceforward(vector<L, T> const &to_orient, vector<L, T> const &incident,
@@ -511,6 +553,9 @@ namespace micro::math {
                    : vector<L, T>{0};
     }
 
+    template<arithmetic T>
+    constexpr fn clamp(T x, T min_val, T max_val) -> T { return min(max(x, min_val), max_val); }
+
     template<core::usize L, arithmetic T>
     constexpr fn clamp(vector<L, T> const &vec, vector<L, T> const &min_val, vector<L, T> const &max_val) -> vector<L, T> { return min(max(vec, min_val), max_val); }
 
@@ -897,6 +942,27 @@ namespace micro::math {
             };
         }
 
+        // inverse of matrix<4, 4, T>::from_euler, i.e. angles of R = Rx(x) * Ry(y) * Rz(z)
+        static fn from_euler(matrix<3, 3, value_type> const &mat) -> type {
+            return type{
+                atan(-mat[2][1], mat[2][2]),
+                asin(clamp(mat[2][0], static_cast<T>(-1), static_cast<T>(1))),
+                atan(-mat[1][0], mat[0][0])
+            };
+        }
+
+        static fn from_euler(matrix<4, 4, value_type> const &mat) -> type { return from_euler(matrix<3, 3, value_type>{mat}); }
+
+        // angles of the given order, see euler.h
+        template<euler_order O>
+        static fn from_euler(matrix<3, 3, value_type> const &mat) -> type { return internal::euler_kernel<O, value_type>::angles(mat); }
+
+        template<euler_order O>
+        static fn from_euler(matrix<4, 4, value_type> const &mat) -> type { return internal::euler_kernel<O, value_type>::angles(matrix<3, 3, value_type>{mat}); }
+
+        template<euler_order O, floating_point U>
+        static fn from_euler(quaternion<U> const &quat) -> type { return internal::euler_kernel<O, U>::angles(matrix<3, 3, U>::from_quaternion(quat)); }
+
         // unary operators
         constexpr fn operator=(type const &vec) -> type & {
             x = vec.x;
@@ -980,11 +1046,11 @@ namespace micro::math {
     };
 
     template<arithmetic T>
-    constexpr fn operator*(T scalar, vector<3, T> const &vec) -> vector<3, T> { return {vec.x * scalar, vec.y * scalar, vec.z * scalar}; }
+    constexpr fn operator*(T scalar, vector<3, T> const &vec) -> vector<3, T> { return vec * scalar; }
 
     // vector4 definition
     template<arithmetic T>
-    struct vector<4, T> {
+    struct alignas(internal::vector_alignment<4, T>) vector<4, T> {
         using size_type = core::usize;
         using value_type = T;
 
@@ -1217,9 +1283,23 @@ namespace micro::math {
 
         constexpr fn operator+() const -> type { return this; }
 
-        constexpr fn operator-() const -> type { return {-(this->x), -(this->y), -(this->z), -(this->w)}; }
+        constexpr fn operator-() const -> type {
+#ifdef MICRO_MATHEMATICS_SIMD_SSE
+            if constexpr (internal::vector_simd<dimensions, value_type>)
+                if (!std::is_constant_evaluated())
+                    return internal::simd::neg(*this);
+#endif
+            return {-(this->x), -(this->y), -(this->z), -(this->w)};
+        }
 
         constexpr fn operator+=(type const &vec) -> type & {
+#ifdef MICRO_MATHEMATICS_SIMD_SSE
+            if constexpr (internal::vector_simd<dimensions, value_type>)
+                if (!std::is_constant_evaluated()) {
+                    *this = internal::simd::add(*this, vec);
+                    return *this;
+                }
+#endif
             this->x += vec.x;
             this->y += vec.y;
             this->z += vec.z;
@@ -1228,6 +1308,13 @@ namespace micro::math {
         }
 
         constexpr fn operator-=(type const &vec) -> type & {
+#ifdef MICRO_MATHEMATICS_SIMD_SSE
+            if constexpr (internal::vector_simd<dimensions, value_type>)
+                if (!std::is_constant_evaluated()) {
+                    *this = internal::simd::sub(*this, vec);
+                    return *this;
+                }
+#endif
             this->x -= vec.x;
             this->y -= vec.y;
             this->z -= vec.z;
@@ -1236,6 +1323,13 @@ namespace micro::math {
         }
 
         constexpr fn operator*=(value_type scalar) -> type & {
+#ifdef MICRO_MATHEMATICS_SIMD_SSE
+            if constexpr (internal::vector_simd<dimensions, value_type>)
+                if (!std::is_constant_evaluated()) {
+                    *this = internal::simd::mul(*this, scalar);
+                    return *this;
+                }
+#endif
             this->x *= scalar;
             this->y *= scalar;
             this->z *= scalar;
@@ -1244,6 +1338,13 @@ namespace micro::math {
         }
 
         constexpr fn operator/=(value_type scalar) -> type & {
+#ifdef MICRO_MATHEMATICS_SIMD_SSE
+            if constexpr (internal::vector_simd<dimensions, value_type>)
+                if (!std::is_constant_evaluated()) {
+                    *this = internal::simd::div(*this, scalar);
+                    return *this;
+                }
+#endif
             this->x /= scalar;
             this->y /= scalar;
             this->z /= scalar;
@@ -1281,13 +1382,41 @@ namespace micro::math {
         }
 
         // binary operators
-        constexpr fn operator+(type const &vec) const -> type { return {this->x + vec.x, this->y + vec.y, this->z + vec.z, this->w + vec.w}; }
-
-        constexpr fn operator-(type const &vec) const -> type { return {this->x - vec.x, this->y - vec.y, this->z - vec.z, this->w - vec.w}; }
-
-        constexpr fn operator*(value_type scalar) const -> type { return {this->x * scalar, this->y * scalar, this->z * scalar, this->w * scalar}; }
-
-        constexpr fn operator/(value_type scalar) const -> type { return {this->x / scalar, this->y / scalar, this->z / scalar, this->w / scalar}; }
+        constexpr fn operator+(type const &vec) const -> type {
+#ifdef MICRO_MATHEMATICS_SIMD_SSE
+            if constexpr (internal::vector_simd<dimensions, value_type>)
+                if (!std::is_constant_evaluated())
+                    return internal::simd::add(*this, vec);
+#endif
+            return {this->x + vec.x, this->y + vec.y, this->z + vec.z, this->w + vec.w};
+        }
+
+        constexpr fn operator-(type const &vec) const -> type {
+#ifdef MICRO_MATHEMATICS_SIMD_SSE
+            if constexpr (internal::vector_simd<dimensions, value_type>)
+                if (!std::is_constant_evaluated())
+                    return internal::simd::sub(*this, vec);
+#endif
+            return {this->x - vec.x, this->y - vec.y, this->z - vec.z, this->w - vec.w};
+        }
+
+        constexpr fn operator*(value_type scalar) const -> type {
+#ifdef MICRO_MATHEMATICS_SIMD_SSE
+            if constexpr (internal::vector_simd<dimensions, value_type>)
+                if (!std::is_constant_evaluated())
+                    return internal::simd::mul(*this, scalar);
+#endif
+            return {this->x * scalar, this->y * scalar, this->z * scalar, this->w * scalar};
+        }
+
+        constexpr fn operator/(value_type scalar) const -> type {
+#ifdef MICRO_MATHEMATICS_SIMD_SSE
+            if constexpr (internal::vector_simd<dimensions, value_type>)
+                if (!std::is_constant_evaluated())
+                    return internal::simd::div(*this, scalar);
+#endif
+            return {this->x / scalar, this->y / scalar, this->z / scalar, this->w / scalar};
+        }
 
         // boolean operators
         constexpr fn operator==(type const &vec) const -> bool { return this->x == vec.x && this->y == vec.y && this->z == vec.z && this->w == vec.w; }
@@ -1296,7 +1425,7 @@ namespace micro::math {
     };
 
     template<arithmetic T>
-    constexpr fn operator*(T scalar, vector<4, T> const &vec) -> vector<4, T> { return {vec.x * scalar, vec.y * scalar, vec.z * scalar, vec.w * scalar}; }
+    constexpr fn operator*(T scalar, vector<4, T> const &vec) -> vector<4, T> { return vec * scalar; }
 
     namespace internal {
         template<core::usize C, core::usize R, arithmetic T>
@@ -1326,7 +1455,7 @@ namespace micro::math {
 
         template<arithmetic T>
         struct matrix_transpose<4, 4, T> {
-            static constexpr fn compute(matrix<3, 3, T> const &mat) -> matrix<3, 3, T> {
+            static constexpr fn compute(matrix<4, 4, T> const &mat) -> matrix<4, 4, T> {
                 return {
                     mat[0][0],
                     mat[1][0],
@@ -1413,7 +1542,7 @@ namespace micro::math {
         template<floating_point T>
         struct matrix_inverse<3, 3, T> {
             static constexpr fn compute(matrix<3, 3, T> const &mat) -> matrix<3, 3, T> {
-                auto det = determinant(mat);
+                auto invDet = static_cast<T>(1) / determinant(mat);
 
                 auto A00 = mat[0][0];
                 auto A01 = mat[0][1];
@@ -1426,15 +1555,15 @@ namespace micro::math {
                 auto A22 = mat[2][2];
 
                 return {
-                    (A11 * A22 - A21 * A12) * det,
-                    -(A01 * A22 - A21 * A02) * det,
-                    (A01 * A12 - A11 * A02) * det,
-                    -(A10 * A22 - A20 * A12) * det,
-                    (A00 * A22 - A20 * A02) * det,
-                    -(A00 * A12 - A10 * A02) * det,
-                    (A10 * A21 - A20 * A11) * det,
-                    -(A00 * A21 - A20 * A01) * det,
-                    (A00 * A11 - A10 * A01) * det
+                    (A11 * A22 - A21 * A12) * invDet,
+                    -(A01 * A22 - A21 * A02) * invDet,
+                    (A01 * A12 - A11 * A02) * invDet,
+                    -(A10 * A22 - A20 * A12) * invDet,
+                    (A00 * A22 - A20 * A02) * invDet,
+                    -(A00 * A12 - A10 * A02) * invDet,
+                    (A10 * A21 - A20 * A11) * invDet,
+                    -(A00 * A21 - A20 * A01) * invDet,
+                    (A00 * A11 - A10 * A01) * invDet
                 };
             }
         };
@@ -1609,6 +1738,81 @@ namespace micro::math {
         };
     }
 
+    // translate(translation) * rotation * scale(scaling) * translate(-pivot) written out directly, the upper 3x3 is the
+    // rotation with its columns scaled and the translation column is translation - rotation * scaling * pivot
+    template<floating_point T>
+    constexpr fn compose_trs(vector<3, T> const &   translation,
+                             matrix<3, 3, T> const &rotation,
+                             vector<3, T> const &   scaling,
+                             vector<3, T> const &   pivot = vector<3, T>{static_cast<T>(0)}) -> matrix<4, 4, T> {
+        auto const x = rotation[0] * scaling.x;
+        auto const y = rotation[1] * scaling.y;
+        auto const z = rotation[2] * scaling.z;
+
+        return {
+            vector<4, T>{x, static_cast<T>(0)},
+            vector<4, T>{y, static_cast<T>(0)},
+            vector<4, T>{z, static_cast<T>(0)},
+            vector<4, T>{translation - x * pivot.x - y * pivot.y - z * pivot.z, static_cast<T>(1)}
+        };
+    }
+
+    // only the upper 3x3 of the rotation is used
+    template<floating_point T>
+    constexpr fn compose_trs(vector<3, T> const &   translation,
+                             matrix<4, 4, T> const &rotation,
+                             vector<3, T> const &   scaling,
+                             vector<3, T> const &   pivot = vector<3, T>{static_cast<T>(0)}) -> matrix<4, 4, T> {
+        return compose_trs(translation, matrix<3, 3, T>{rotation}, scaling, pivot);
+    }
+
+    template<floating_point T>
+    constexpr fn compose_trs(vector<3, T> const & translation,
+                             quaternion<T> const &rotation,
+                             vector<3, T> const & scaling,
+                             vector<3, T> const & pivot = vector<3, T>{static_cast<T>(0)}) -> matrix<4, 4, T> {
+        return compose_trs(translation, internal::quaternion_to_matrix<3, 3, T>::compute(rotation), scaling, pivot);
+    }
+
+    // inverse of a rotation + translation, the upper 3x3 must be orthonormal: [R | t]^-1 = [R^T | -R^T * t]
+    template<floating_point T>
+    constexpr fn inverse_rigid(matrix<4, 4, T> const &mat) -> matrix<4, 4, T> {
+        vector<3, T> const x{mat[0]};
+        vector<3, T> const y{mat[1]};
+        vector<3, T> const z{mat[2]};
+        vector<3, T> const t{mat[3]};
+
+        return {
+            vector<4, T>{x.x, y.x, z.x, static_cast<T>(0)},
+            vector<4, T>{x.y, y.y, z.y, static_cast<T>(0)},
+            vector<4, T>{x.z, y.z, z.z, static_cast<T>(0)},
+            vector<4, T>{-dot(x, t), -dot(y, t), -dot(z, t), static_cast<T>(1)}
+        };
+    }
+
+    // inverse of any matrix whose last row is (0, 0, 0, 1): [A | t]^-1 = [A^-1 | -A^-1 * t], the rows of A^-1 are the
+    // pairwise cross products of A's columns over its determinant
+    template<floating_point T>
+    constexpr fn inverse_affine(matrix<4, 4, T> const &mat) -> matrix<4, 4, T> {
+        vector<3, T> const x{mat[0]};
+        vector<3, T> const y{mat[1]};
+        vector<3, T> const z{mat[2]};
+        vector<3, T> const t{mat[3]};
+
+        auto const r0 = cross(y, z);
+        auto const r1 = cross(z, x);
+        auto const r2 = cross(x, y);
+
+        auto const invDet = static_cast<T>(1) / dot(x, r0);
+
+        return {
+            vector<4, T>{r0.x * invDet, r1.x * invDet, r2.x * invDet, static_cast<T>(0)},
+            vector<4, T>{r0.y * invDet, r1.y * invDet, r2.y * invDet, static_cast<T>(0)},
+            vector<4, T>{r0.z * invDet, r1.z * invDet, r2.z * invDet, static_cast<T>(0)},
+            vector<4, T>{-dot(r0, t) * invDet, -dot(r1, t) * invDet, -dot(r2, t) * invDet, static_cast<T>(1)}
+        };
+    }
+
     // matrix2x2 definition
     template<arithmetic T>
     class matrix<2, 2, T> {
@@ -1900,6 +2104,9 @@ namespace micro::math {
 
         static constexpr fn from_quaternion(quaternion<T> const &quat) -> type { return internal::quaternion_to_matrix<columns, rows, value_type>::compute(quat); }
 
+        template<euler_order O>
+        static fn from_euler(vector<3, value_type> const &angles) -> type { return internal::euler_kernel<O, value_type>::matrix(angles); }
+
         // unary operators
         constexpr fn operator=(type const &mat) -> type & {
             if (this == &mat)
@@ -2188,6 +2395,9 @@ namespace micro::math {
             return res;
         }
 
+        template<euler_order O>
+        static fn from_euler(vector<3, value_type> const &angles) -> type { return type{internal::euler_kernel<O, value_type>::matrix(angles)}; }
+
         static constexpr fn ortho(value_type left,
                                   value_type right,
                                   value_type bottom,
@@ -2392,7 +2602,7 @@ namespace micro::math {
     fn normalize(quaternion<T> const &quat) -> quaternion<T> { return quat / magnitude(quat); }
 
     template<floating_point T>
-    constexpr fn conjugate(quaternion<T> const &quat) -> quaternion<T> { return {quat.w, -quat.x, -quat.y, -quat.z}; }
+    constexpr fn conjugate(quaternion<T> const &quat) -> quaternion<T> { return {quat.s, -quat.x, -quat.y, -quat.z}; }
 
     template<floating_point T>
     constexpr fn inverse(quaternion<T> const &quat) -> quaternion<T> { return conjugate(quat) / dot(quat, quat); }
@@ -2594,6 +2804,9 @@ namespace micro::math {
 
         static constexpr fn from_euler(vector<3, T> const &vec) -> type { return type{vec}; }
 
+        template<euler_order O>
+        static fn from_euler(vector<3, T> const &angles) -> type { return internal::euler_kernel<O, T>::quaternion(angles); }
+
         static constexpr fn from_matrix3x3(matrix<3, 3, T> const &mat) -> type { return type{mat}; }
 
         static constexpr fn from_matrix4x4(matrix<4, 4, T> const &mat) -> type { return type{mat}; }
@@ -2668,10 +2881,10 @@ namespace micro::math {
             vector<3, value_type> uv(cross(u, vec));
             vector<3, value_type> uuv(cross(u, uv));
 
-            return vec + ((uv * this->w) + uuv) * static_cast<value_type>(2);
+            return vec + ((uv * this->s) + uuv) * static_cast<value_type>(2);
         }
 
-        constexpr fn operator*(vector<4, value_type> const &vec) const -> vector<4, value_type> { return {*this * vector<3, value_type>(vec), vec.s}; }
+        constexpr fn operator*(vector<4, value_type> const &vec) const -> vector<4, value_type> { return {*this * vector<3, value_type>(vec), vec.w}; }
 
         constexpr fn operator*(value_type scalar) const -> type { return {this->s * scalar, this->x * scalar, this->y * scalar, this->z * scalar}; }
 
@@ -2697,6 +2910,164 @@ namespace micro::math {
             quat * scalar;
     }
 
+    // affine3x4 definition, the upper three rows of a matrix4x4 whose last row is (0, 0, 0, 1), stored row-major so
+    // every output coordinate is one 4-wide dot product, 48 bytes instead of 64
+    template<floating_point T>
+    struct affine3x4 {
+        using size_type = core::usize;
+        using value_type = T;
+
+        static constexpr size_type columns = 4;
+        static constexpr size_type rows    = 3;
+
+        using row_type = vector<columns, value_type>;
+
+        using type = affine3x4<value_type>;
+
+        // member access operators, unlike matrix these index rows
+        constexpr fn operator[](size_type i) -> row_type & {
+            assert(i >= 0 && i < this->rows);
+            return this->values[i];
+        }
+
+        constexpr fn operator[](size_type i) const -> row_type const & {
+            assert(i >= 0 && i < this->rows);
+            return this->values[i];
+        }
+
+        // constructors
+        constexpr affine3x4() = default;
+
+        constexpr affine3x4(row_type const &row0, row_type const &row1, row_type const &row2) : values{row0, row1, row2} {}
+
+        explicit constexpr affine3x4(value_type scalar)
+            : values{
+                row_type{scalar, 0, 0, 0},
+                row_type{0, scalar, 0, 0},
+                row_type{0, 0, scalar, 0}
+            } {}
+
+        constexpr affine3x4(matrix<3, 3, value_type> const &mat, vector<3, value_type> const &translation)
+            : values{
+                row_type{mat[0][0], mat[1][0], mat[2][0], translation.x},
+                row_type{mat[0][1], mat[1][1], mat[2][1], translation.y},
+                row_type{mat[0][2], mat[1][2], mat[2][2], translation.z}
+            } {}
+
+        // drops the last row
+        explicit constexpr affine3x4(matrix<4, 4, value_type> const &mat)
+            : values{
+                row_type{mat[0][0], mat[1][0], mat[2][0], mat[3][0]},
+                row_type{mat[0][1], mat[1][1], mat[2][1], mat[3][1]},
+                row_type{mat[0][2], mat[1][2], mat[2][2], mat[3][2]}
+            } {}
+
+        explicit constexpr affine3x4(matrix<3, 3, value_type> const &mat) : affine3x4{mat, vector<3, value_type>{0}} {}
+
+        explicit constexpr affine3x4(quaternion<value_type> const &quat)
+            : affine3x4{internal::quaternion_to_matrix<3, 3, value_type>::compute(quat), vector<3, value_type>{0}} {}
+
+        static constexpr fn identity() -> type { return type{1}; }
+
+        static constexpr fn from_matrix4x4(matrix<4, 4, value_type> const &mat) -> type { return type{mat}; }
+
+        static constexpr fn from_quaternion(quaternion<value_type> const &quat,
+                                            vector<3, value_type> const & translation = vector<3, value_type>{0}) -> type {
+            return type{internal::quaternion_to_matrix<3, 3, value_type>::compute(quat), translation};
+        }
+
+        static fn from_rotation(value_type angle, vector<3, value_type> const &axis) -> type {
+            auto const c = cos(angle);
+            auto const s = sin(angle);
+
+            vector<3, value_type> const a{normalize(axis)};
+            vector<3, value_type> const t{(static_cast<T>(1) - c) * a};
+
+            return {
+                row_type{c + t.x * a.x, t.y * a.x - s * a.z, t.z * a.x + s * a.y, 0},
+                row_type{t.x * a.y + s * a.z, c + t.y * a.y, t.z * a.y - s * a.x, 0},
+                row_type{t.x * a.z - s * a.y, t.y * a.z + s * a.x, c + t.z * a.z, 0}
+            };
+        }
+
+        // conversions
+        constexpr fn rotation() const -> matrix<3, 3, value_type> {
+            return {
+                values[0].x, values[1].x, values[2].x,
+                values[0].y, values[1].y, values[2].y,
+                values[0].z, values[1].z, values[2].z
+            };
+        }
+
+        constexpr fn translation() const -> vector<3, value_type> { return {values[0].w, values[1].w, values[2].w}; }
+
+        constexpr fn to_matrix4x4() const -> matrix<4, 4, value_type> {
+            return {
+                vector<4, value_type>{values[0].x, values[1].x, values[2].x, 0},
+                vector<4, value_type>{values[0].y, values[1].y, values[2].y, 0},
+                vector<4, value_type>{values[0].z, values[1].z, values[2].z, 0},
+                vector<4, value_type>{values[0].w, values[1].w, values[2].w, 1}
+            };
+        }
+
+        // the rotation block must be orthonormal
+        constexpr fn to_quaternion() const -> quaternion<value_type> { return quaternion<value_type>{rotation()}; }
+
+        // transforms
+        constexpr fn transform_point(vector<3, value_type> const &point) const -> vector<3, value_type> {
+            vector<4, value_type> const p{point, static_cast<T>(1)};
+            return {dot(values[0], p), dot(values[1], p), dot(values[2], p)};
+        }
+
+        constexpr fn transform_vector(vector<3, value_type> const &vec) const -> vector<3, value_type> {
+            vector<4, value_type> const v{vec, static_cast<T>(0)};
+            return {dot(values[0], v), dot(values[1], v), dot(values[2], v)};
+        }
+
+        // binary operators
+        constexpr fn operator*(vector<4, value_type> const &vec) const -> vector<4, value_type> { return {dot(values[0], vec), dot(values[1], vec), dot(values[2], vec), vec.w}; }
+
+        // 36 multiply-adds, the implicit last row of both operands is never touched
+        constexpr fn operator*(type const &aff) const -> type {
+            return {
+                aff[0] * values[0].x + aff[1] * values[0].y + aff[2] * values[0].z + row_type{0, 0, 0, values[0].w},
+                aff[0] * values[1].x + aff[1] * values[1].y + aff[2] * values[1].z + row_type{0, 0, 0, values[1].w},
+                aff[0] * values[2].x + aff[1] * values[2].y + aff[2] * values[2].z + row_type{0, 0, 0, values[2].w}
+            };
+        }
+
+        constexpr fn operator*=(type const &aff) -> type & { return *this = *this * aff; }
+
+        // boolean operators
+        constexpr fn operator==(type const &aff) const -> bool { return values[0] == aff[0] && values[1] == aff[1] && values[2] == aff[2]; }
+
+        constexpr fn operator!=(type const &aff) const -> bool { return values[0] != aff[0] || values[1] != aff[1] || values[2] != aff[2]; }
+
+        // members
+    private:
+        row_type values[rows];
+    };
+
+    template<floating_point T>
+    constexpr fn inverse(affine3x4<T> const &aff) -> affine3x4<T> { return affine3x4<T>{inverse_affine(aff.to_matrix4x4())}; }
+
+    template<floating_point T>
+    constexpr fn inverse_rigid(affine3x4<T> const &aff) -> affine3x4<T> {
+        auto const rot = aff.rotation();
+        auto const t   = aff.translation();
+
+        // rows of the inverse are the columns of the rotation
+        return {
+            vector<4, T>{rot[0], -dot(rot[0], t)},
+            vector<4, T>{rot[1], -dot(rot[1], t)},
+            vector<4, T>{rot[2], -dot(rot[2], t)}
+        };
+    }
+
+    // post-multiplies by a rotation, same convention as rotate(matrix<4, 4, T>, ...)
+    template<floating_point T>
+    fn rotate(affine3x4<T> const &aff, T angle, vector<3, T> const &vec) -> affine3x4<T> { return aff * affine3x4<T>::from_rotation(angle, vec); }
+
     template<arithmetic T>
     auto value_ptr(vector<2, T> const &v) -> const T * { return &(v.x); }
 
@@ -2738,6 +3109,12 @@ namespace micro::math {
 
     template<floating_point T>
     auto value_ptr(quaternion<T> &q) -> T * { return &(q[0]); }
+
+    template<floating_point T>
+    auto value_ptr(affine3x4<T> const &a) -> T const * { return &(a[0].x); }
+
+    template<floating_point T>
+    auto value_ptr(affine3x4<T> &a) -> T * { return &(a[0].x); }
 }
 
 #endif //MICRO_MATHEMATICS_LINEAR_H
@@ -0,0 +1,346 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+#ifndef MICRO_MATHEMATICS_QUATERNION_TREE_H
+#define MICRO_MATHEMATICS_QUATERNION_TREE_H
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <numbers>
+#include <numeric>
+#include <queue>
+#include <vector>
+
+#include "linear.h"
+#include "../core/types.h"
+
+namespace micro::math {
+    // k-d tree over unit quaternions canonicalized to the s >= 0 hemisphere, every query is run against both q and -q
+    // so the distance between two stored rotations is the chord 2 - 2 * |dot(p, q)|, monotonic in the rotation angle
+    template<floating_point T>
+    class quaternion_tree {
+    public:
+        using size_type = core::usize;
+        using value_type = T;
+
+        static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+        struct neighbour {
+            size_type  id;
+            value_type angle;
+        };
+
+        fn build(quaternion<T> const *quats, size_type count) -> void;
+
+        fn build(std::vector<quaternion<T>> const &quats) -> void { build(quats.data(), quats.size()); }
+
+        // returns the id of the inserted quaternion, ids are assigned in insertion order
+        fn insert(quaternion<T> const &quat) -> size_type;
+
+        // removes the quaternion inserted last, only the subtree below it is split again
+        fn pop_back() -> void;
+
+        fn clear() -> void;
+
+        [[nodiscard]] fn size() const -> size_type { return points.size(); }
+
+        [[nodiscard]] fn empty() const -> bool { return points.empty(); }
+
+        // all stored rotations within the given rotation angle, ordered by angle
+        [[nodiscard]] fn radius(quaternion<T> const &quat, value_type angle) const -> std::vector<neighbour>;
+
+        // the k closest stored rotations, ordered by angle
+        [[nodiscard]] fn nearest(quaternion<T> const &quat, size_type k) const -> std::vector<neighbour>;
+
+        // true as soon as one stored rotation lies within the given rotation angle
+        [[nodiscard]] fn contains(quaternion<T> const &quat, value_type angle) const -> bool;
+
+    private:
+        struct node {
+            size_type left   = npos;
+            size_type right  = npos;
+            size_type parent = npos;
+            size_type size   = 1;
+            core::u8  axis   = 0;
+        };
+
+        std::vector<vector<4, T>> points{};
+        std::vector<node>         nodes{};
+        size_type                 root = npos;
+
+        static fn canonical(quaternion<T> const &quat) -> vector<4, T> {
+            return quat.s < static_cast<T>(0)
+                       ? vector<4, T>{-quat.s, -quat.x, -quat.y, -quat.z}
+                       : vector<4, T>{quat.s, quat.x, quat.y, quat.z};
+        }
+
+        static fn chord(vector<4, T> const &p, vector<4, T> const &q) -> value_type { return static_cast<T>(2) - static_cast<T>(2) * abs(dot(p, q)); }
+
+        static fn chord(value_type angle) -> value_type { return static_cast<T>(2) - static_cast<T>(2) * cos(min(angle, static_cast<T>(2) * std::numbers::pi_v<T>) / static_cast<T>(2)); }
+
+        static fn angle(value_type chord) -> value_type { return static_cast<T>(2) * acos(clamp(static_cast<T>(1) - chord / static_cast<T>(2), static_cast<T>(-1), static_cast<T>(1))); }
+
+        fn split(size_type *first, size_type *last) -> size_type;
+
+        // splits the subtree again, leaving out the given id, the caller links the returned root to the parent
+        fn rebuild(size_type subtree, size_type skip = npos) -> size_type;
+
+        // visits every point whose chord to the query can be within the bound, the bound may shrink while searching
+        template<typename Visitor>
+        fn search(vector<4, T> const &query, value_type const &bound, Visitor &&visit) const -> void;
+    };
+
+    template<floating_point T>
+    fn quaternion_tree<T>::build(quaternion<T> const *quats, size_type count) -> void {
+        points.resize(count);
+        std::transform(quats, quats + count, points.begin(), canonical);
+
+        nodes.assign(count, node{});
+
+        std::vector<size_type> ids(count);
+        std::iota(ids.begin(), ids.end(), 0);
+        root = split(ids.data(), ids.data() + ids.size());
+    }
+
+    template<floating_point T>
+    fn quaternion_tree<T>::split(size_type *first, size_type *last) -> size_type {
+        if (first == last)
+            return npos;
+
+        // split along the axis with the largest spread
+        vector<4, T> lo{std::numeric_limits<T>::max()};
+        vector<4, T> hi{std::numeric_limits<T>::lowest()};
+        for (auto it = first; it != last; ++it) {
+            lo = min(lo, points[*it]);
+            hi = max(hi, points[*it]);
+        }
+        auto const spread = hi - lo;
+
+        core::u8 axis = 0;
+        for (core::u8 i = 1; i < 4; ++i)
+            if (spread[i] > spread[axis])
+                axis = i;
+
+        auto const middle = first + (last - first) / 2;
+        std::nth_element(first, middle, last,
+                         [&](size_type a, size_type b) { return points[a][axis] < points[b][axis]; });
+
+        auto &n = nodes[*middle];
+        n.axis  = axis;
+        n.size  = static_cast<size_type>(last - first);
+        n.left  = split(first, middle);
+        n.right = split(middle + 1, last);
+        if (n.left != npos)
+            nodes[n.left].parent = *middle;
+        if (n.right != npos)
+            nodes[n.right].parent = *middle;
+        return *middle;
+    }
+
+    template<floating_point T>
+    fn quaternion_tree<T>::rebuild(size_type subtree, size_type skip) -> size_type {
+        std::vector<size_type> ids{};
+        ids.reserve(nodes[subtree].size);
+
+        std::vector<size_type> stack{subtree};
+        while (!stack.empty()) {
+            auto const current = stack.back();
+            stack.pop_back();
+            if (current != skip)
+                ids.push_back(current);
+
+            auto const &n = nodes[current];
+            if (n.left != npos)
+                stack.push_back(n.left);
+            if (n.right != npos)
+                stack.push_back(n.right);
+        }
+
+        for (auto const id : ids)
+            nodes[id] = node{};
+        return split(ids.data(), ids.data() + ids.size());
+    }
+
+    template<floating_point T>
+    fn quaternion_tree<T>::insert(quaternion<T> const &quat) -> size_type {
+        auto const id = points.size();
+        points.emplace_back(canonical(quat));
+        nodes.emplace_back(node{});
+
+        if (root == npos) {
+            root = id;
+            return id;
+        }
+
+        std::vector<size_type> path{};
+        auto                   current = root;
+        while (current != npos) {
+            path.push_back(current);
+
+            auto &n = nodes[current];
+            ++n.size;
+            auto &child = points[id][n.axis] < points[current][n.axis] ? n.left : n.right;
+            if (child == npos) {
+                child            = id;
+                nodes[id].axis   = static_cast<core::u8>((n.axis + 1) % 4);
+                nodes[id].parent = current;
+            }
+            current = child == id ? npos : child;
+        }
+        path.push_back(id);
+
+        // scapegoat rebalancing, once the path is deeper than log_{1/alpha}(n) some ancestor holds more than alpha of
+        // its subtree in a single child, only the topmost such subtree is rebuilt
+        if (path.size() <= 2 * static_cast<size_type>(std::bit_width(points.size())) + 2)
+            return id;
+
+        constexpr auto alpha = 0.7;
+        for (size_type i = 0; i + 1 < path.size(); ++i) {
+            auto const &n = nodes[path[i]];
+            if (static_cast<double>(nodes[path[i + 1]].size) <= alpha * static_cast<double>(n.size))
+                continue;
+
+            auto const subtree = rebuild(path[i]);
+            if (i == 0)
+                root = subtree;
+            else {
+                auto &parent = nodes[path[i - 1]];
+                (parent.left == path[i] ? parent.left : parent.right) = subtree;
+                nodes[subtree].parent = path[i - 1];
+            }
+            break;
+        }
+
+        return id;
+    }
+
+    template<floating_point T>
+    fn quaternion_tree<T>::pop_back() -> void {
+        if (points.empty())
+            return;
+
+        auto const id     = points.size() - 1;
+        auto const parent = nodes[id].parent;
+        for (auto ancestor = parent; ancestor != npos; ancestor = nodes[ancestor].parent)
+            --nodes[ancestor].size;
+
+        // a leaf is just unlinked, the children of an inner node are split again without it
+        auto const &n       = nodes[id];
+        auto const  subtree = n.left == npos && n.right == npos ? npos : rebuild(id, id);
+        if (parent == npos)
+            root = subtree;
+        else
+            (nodes[parent].left == id ? nodes[parent].left : nodes[parent].right) = subtree;
+        if (subtree != npos)
+            nodes[subtree].parent = parent;
+
+        points.pop_back();
+        nodes.pop_back();
+    }
+
+    template<floating_point T>
+    fn quaternion_tree<T>::clear() -> void {
+        points.clear();
+        nodes.clear();
+        root = npos;
+    }
+
+    template<floating_point T>
+    template<typename Visitor>
+    fn quaternion_tree<T>::search(vector<4, T> const &query, value_type const &bound, Visitor &&visit) const -> void {
+        if (root == npos)
+            return;
+
+        auto const antipode = -query;
+
+        std::vector<size_type> stack{};
+        stack.reserve(64);
+        stack.push_back(root);
+        while (!stack.empty()) {
+            auto const current = stack.back();
+            stack.pop_back();
+
+            auto const &n = nodes[current];
+            auto const &p = points[current];
+
+            if (!visit(current, chord(p, query)))
+                return;
+
+            // squared distance from either query to the splitting plane bounds the chord of anything behind it
+            auto const d1 = query[n.axis] - p[n.axis];
+            auto const d2 = antipode[n.axis] - p[n.axis];
+
+            auto const leftBound  = min(d1 > 0 ? d1 * d1 : static_cast<T>(0), d2 > 0 ? d2 * d2 : static_cast<T>(0));
+            auto const rightBound = min(d1 < 0 ? d1 * d1 : static_cast<T>(0), d2 < 0 ? d2 * d2 : static_cast<T>(0));
+
+            if (n.left != npos && leftBound <= bound)
+                stack.push_back(n.left);
+            if (n.right != npos && rightBound <= bound)
+                stack.push_back(n.right);
+        }
+    }
+
+    template<floating_point T>
+    fn quaternion_tree<T>::radius(quaternion<T> const &quat, value_type angle_) const -> std::vector<neighbour> {
+        auto const query = canonical(quat);
+        auto const bound = chord(angle_);
+
+        std::vector<neighbour> result{};
+        search(query, bound, [&](size_type id, value_type distance) {
+            if (distance <= bound)
+                result.emplace_back(neighbour{id, angle(distance)});
+            return true;
+        });
+
+        std::sort(result.begin(), result.end(),
+                  [](neighbour const &a, neighbour const &b) { return a.angle < b.angle || (a.angle == b.angle && a.id < b.id); });
+        return result;
+    }
+
+    template<floating_point T>
+    fn quaternion_tree<T>::nearest(quaternion<T> const &quat, size_type k) const -> std::vector<neighbour> {
+        if (k == 0)
+            return {};
+
+        auto const query = canonical(quat);
+        auto       bound = std::numeric_limits<T>::max();
+
+        auto const closer = [](std::pair<value_type, size_type> const &a, std::pair<value_type, size_type> const &b) { return a < b; };
+        std::priority_queue<std::pair<value_type, size_type>, std::vector<std::pair<value_type, size_type>>, decltype(closer)> best{closer};
+
+        search(query, bound, [&](size_type id, value_type distance) {
+            if (best.size() < k)
+                best.emplace(distance, id);
+            else if (distance < best.top().first) {
+                best.pop();
+                best.emplace(distance, id);
+            }
+            if (best.size() == k)
+                bound = best.top().first;
+            return true;
+        });
+
+        std::vector<neighbour> result(best.size());
+        for (auto it = result.rbegin(); it != result.rend(); ++it) {
+            *it = neighbour{best.top().second, angle(best.top().first)};
+            best.pop();
+        }
+        return result;
+    }
+
+    template<floating_point T>
+    fn quaternion_tree<T>::contains(quaternion<T> const &quat, value_type angle_) const -> bool {
+        auto const bound = chord(angle_);
+
+        auto found = false;
+        search(canonical(quat), bound, [&](size_type, value_type distance) {
+            found = distance <= bound;
+            return !found;
+        });
+        return found;
+    }
+}
+
+#endif //MICRO_MATHEMATICS_QUATERNION_TREE_H
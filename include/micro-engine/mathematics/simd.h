@@ -0,0 +1,93 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+#ifndef MICRO_MATHEMATICS_SIMD_H
+#define MICRO_MATHEMATICS_SIMD_H
+
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <immintrin.h>
+#define MICRO_MATHEMATICS_SSE
+#endif
+
+// opt-in SIMD storage, MICRO_MATHEMATICS_SIMD enables the SSE backend of vector<4, f32> (same members, 16 byte aligned,
+// which also grows every struct holding one, Vertex goes from 52 to 64 bytes), vector<3, f32> stays packed since
+// padding it to a lane made the quaternion rotation and lookAt several times slower than the scalar code
+#if defined(MICRO_MATHEMATICS_SIMD) && defined(MICRO_MATHEMATICS_SSE)
+#define MICRO_MATHEMATICS_SIMD_SSE
+#endif
+
+#include "../core/types.h"
+
+namespace micro::math::internal {
+    // true when vector<L, T> arithmetic goes through the SIMD backend
+    template<core::usize L, typename T>
+    inline constexpr bool vector_simd = false;
+
+    // storage alignment of vector<L, T>
+    template<core::usize L, typename T>
+    inline constexpr core::usize vector_alignment = alignof(T);
+
+#ifdef MICRO_MATHEMATICS_SIMD_SSE
+    template<>
+    inline constexpr bool vector_simd<4, float> = true;
+
+    template<>
+    inline constexpr core::usize vector_alignment<4, float> = 16;
+
+    // every SIMD-backed vector keeps its lanes in x, y, z, w order, the helpers are generic over the vector type so they
+    // can be declared before the vector specializations are complete
+    namespace simd {
+        template<typename V>
+        fn load(V const &vec) -> __m128 { return _mm_load_ps(&vec.x); }
+
+        template<typename V>
+        fn store(__m128 value) -> V {
+            V vec;
+            _mm_store_ps(&vec.x, value);
+            return vec;
+        }
+
+        template<typename V>
+        fn add(V const &a, V const &b) -> V { return store<V>(_mm_add_ps(load(a), load(b))); }
+
+        template<typename V>
+        fn sub(V const &a, V const &b) -> V { return store<V>(_mm_sub_ps(load(a), load(b))); }
+
+        template<typename V>
+        fn mul(V const &a, float scalar) -> V { return store<V>(_mm_mul_ps(load(a), _mm_set1_ps(scalar))); }
+
+        template<typename V>
+        fn div(V const &a, float scalar) -> V { return store<V>(_mm_div_ps(load(a), _mm_set1_ps(scalar))); }
+
+        template<typename V>
+        fn neg(V const &a) -> V { return store<V>(_mm_xor_ps(load(a), _mm_set1_ps(-0.f))); }
+
+        template<typename V>
+        fn min(V const &a, V const &b) -> V { return store<V>(_mm_min_ps(load(a), load(b))); }
+
+        template<typename V>
+        fn max(V const &a, V const &b) -> V { return store<V>(_mm_max_ps(load(a), load(b))); }
+
+        // horizontal sum of all four lanes, broadcast to every lane
+        inline fn sum(__m128 value) -> __m128 {
+            auto const shuffled = _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1));
+            auto const pairs    = _mm_add_ps(value, shuffled);
+            return _mm_add_ps(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 0, 3, 2)));
+        }
+
+        template<typename V>
+        fn dot(V const &a, V const &b) -> float { return _mm_cvtss_f32(sum(_mm_mul_ps(load(a), load(b)))); }
+
+        template<typename V>
+        fn normalize(V const &a) -> V {
+            auto const value = load(a);
+            return store<V>(_mm_div_ps(value, _mm_sqrt_ps(sum(_mm_mul_ps(value, value)))));
+        }
+    }
+#endif
+}
+
+#endif //MICRO_MATHEMATICS_SIMD_H
@@ -0,0 +1,474 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+#ifndef MICRO_MATHEMATICS_SOA_H
+#define MICRO_MATHEMATICS_SOA_H
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "linear.h"
+#include "simd.h"
+#include "../core/types.h"
+
+namespace micro::math {
+    namespace internal {
+        // widest vector register the build targets, lanes are aligned to it so kernels never straddle cache lines
+#if defined(__AVX512F__)
+        inline constexpr core::usize soa_alignment = 64;
+#elif defined(__AVX__)
+        inline constexpr core::usize soa_alignment = 32;
+#else
+        inline constexpr core::usize soa_alignment = 16;
+#endif
+
+        template<typename T, core::usize Alignment>
+        struct aligned_allocator {
+            using value_type = T;
+
+            template<typename U>
+            struct rebind {
+                using other = aligned_allocator<U, Alignment>;
+            };
+
+            constexpr aligned_allocator() noexcept = default;
+
+            template<typename U>
+            constexpr aligned_allocator(aligned_allocator<U, Alignment> const &) noexcept {}
+
+            [[nodiscard]] fn allocate(core::usize count) -> T * {
+                if (count > std::numeric_limits<core::usize>::max() / sizeof(T))
+                    throw std::bad_array_new_length{};
+                return static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t{Alignment}));
+            }
+
+            fn deallocate(T *ptr, core::usize) noexcept -> void { ::operator delete(ptr, std::align_val_t{Alignment}); }
+
+            template<typename U>
+            constexpr fn operator==(aligned_allocator<U, Alignment> const &) const noexcept -> bool { return true; }
+        };
+
+        // per-lane min and max of a contiguous range, vectorized for f32 where the target allows it
+        template<floating_point T>
+        struct lane_bounds {
+            static fn compute(T const *values, core::usize count) -> std::pair<T, T> {
+                auto lo = std::numeric_limits<T>::max();
+                auto hi = std::numeric_limits<T>::lowest();
+                for (core::usize i = 0; i < count; ++i) {
+                    lo = min(lo, values[i]);
+                    hi = max(hi, values[i]);
+                }
+                return {lo, hi};
+            }
+        };
+
+#ifdef MICRO_MATHEMATICS_SSE
+        template<>
+        struct lane_bounds<float> {
+            static fn compute(float const *values, core::usize count) -> std::pair<float, float> {
+                core::usize i = 0;
+
+#ifdef __AVX__
+                auto lo8 = _mm256_set1_ps(std::numeric_limits<float>::max());
+                auto hi8 = _mm256_set1_ps(std::numeric_limits<float>::lowest());
+                for (; i + 8 <= count; i += 8) {
+                    auto const v = _mm256_load_ps(values + i);
+                    lo8 = _mm256_min_ps(lo8, v);
+                    hi8 = _mm256_max_ps(hi8, v);
+                }
+                auto lo4 = _mm_min_ps(_mm256_castps256_ps128(lo8), _mm256_extractf128_ps(lo8, 1));
+                auto hi4 = _mm_max_ps(_mm256_castps256_ps128(hi8), _mm256_extractf128_ps(hi8, 1));
+#else
+                auto lo4 = _mm_set1_ps(std::numeric_limits<float>::max());
+                auto hi4 = _mm_set1_ps(std::numeric_limits<float>::lowest());
+#endif
+                for (; i + 4 <= count; i += 4) {
+                    auto const v = _mm_load_ps(values + i);
+                    lo4 = _mm_min_ps(lo4, v);
+                    hi4 = _mm_max_ps(hi4, v);
+                }
+
+                lo4 = _mm_min_ps(lo4, _mm_shuffle_ps(lo4, lo4, _MM_SHUFFLE(2, 3, 0, 1)));
+                lo4 = _mm_min_ps(lo4, _mm_shuffle_ps(lo4, lo4, _MM_SHUFFLE(1, 0, 3, 2)));
+                hi4 = _mm_max_ps(hi4, _mm_shuffle_ps(hi4, hi4, _MM_SHUFFLE(2, 3, 0, 1)));
+                hi4 = _mm_max_ps(hi4, _mm_shuffle_ps(hi4, hi4, _MM_SHUFFLE(1, 0, 3, 2)));
+
+                auto lo = _mm_cvtss_f32(lo4);
+                auto hi = _mm_cvtss_f32(hi4);
+                for (; i < count; ++i) {
+                    lo = min(lo, values[i]);
+                    hi = max(hi, values[i]);
+                }
+                return {lo, hi};
+            }
+        };
+#endif
+    }
+
+    // structure-of-arrays storage for vector3, vector4 and quaternion, every component lives in its own aligned lane so
+    // bulk kernels run over plain contiguous arrays, lanes follow the element's operator[] order (s, x, y, z for quaternions)
+    template<typename E>
+    class soa_array {
+    public:
+        using size_type = core::usize;
+        using element_type = E;
+        using value_type = typename E::value_type;
+
+        static constexpr size_type lanes = E::dimensions;
+
+        using lane_type = std::vector<value_type, internal::aligned_allocator<value_type, internal::soa_alignment>>;
+
+        // proxy to one element, reads gather and writes scatter across the lanes
+        class reference {
+        public:
+            reference(soa_array &array, size_type index) : array{array}, index{index} {}
+
+            operator element_type() const { return array.get(index); }
+
+            fn operator=(element_type const &element) -> reference & {
+                array.set(index, element);
+                return *this;
+            }
+
+            fn operator=(reference const &other) -> reference & { return *this = static_cast<element_type>(other); }
+
+            fn operator[](size_type lane) const -> value_type & { return array.data[lane][index]; }
+
+        private:
+            soa_array &array;
+            size_type  index;
+        };
+
+        // constructors
+        soa_array() = default;
+
+        explicit soa_array(size_type count) { resize(count); }
+
+        explicit soa_array(std::vector<element_type> const &elements) { assign(elements); }
+
+        static fn from(std::vector<element_type> const &elements) -> soa_array { return soa_array{elements}; }
+
+        // member access
+        [[nodiscard]] fn size() const -> size_type { return data[0].size(); }
+
+        [[nodiscard]] fn empty() const -> bool { return data[0].empty(); }
+
+        fn lane(size_type i) -> value_type * { return data[i].data(); }
+
+        fn lane(size_type i) const -> value_type const * { return data[i].data(); }
+
+        fn operator[](size_type i) -> reference { return reference{*this, i}; }
+
+        fn operator[](size_type i) const -> element_type { return get(i); }
+
+        fn get(size_type i) const -> element_type { return gather(i, std::make_index_sequence<lanes>{}); }
+
+        fn set(size_type i, element_type const &element) -> void {
+            for (size_type l = 0; l < lanes; ++l)
+                data[l][i] = element[l];
+        }
+
+        // modifiers
+        fn reserve(size_type count) -> void {
+            for (auto &l : data)
+                l.reserve(count);
+        }
+
+        fn resize(size_type count) -> void {
+            for (auto &l : data)
+                l.resize(count);
+        }
+
+        fn clear() -> void {
+            for (auto &l : data)
+                l.clear();
+        }
+
+        fn push_back(element_type const &element) -> void {
+            for (size_type l = 0; l < lanes; ++l)
+                data[l].push_back(element[l]);
+        }
+
+        // conversions from and to array-of-structs
+        fn assign(element_type const *elements, size_type count) -> void {
+            resize(count);
+            for (size_type l = 0; l < lanes; ++l) {
+                auto *out = data[l].data();
+                for (size_type i = 0; i < count; ++i)
+                    out[i] = elements[i][l];
+            }
+        }
+
+        fn assign(std::vector<element_type> const &elements) -> void { assign(elements.data(), elements.size()); }
+
+        fn store(element_type *elements) const -> void {
+            for (size_type i = 0; i < size(); ++i)
+                elements[i] = get(i);
+        }
+
+        [[nodiscard]] fn to_aos() const -> std::vector<element_type> {
+            std::vector<element_type> elements(size());
+            store(elements.data());
+            return elements;
+        }
+
+    private:
+        std::array<lane_type, lanes> data{};
+
+        template<size_type... L>
+        fn gather(size_type i, std::index_sequence<L...>) const -> element_type { return element_type{data[L][i]...}; }
+    };
+
+    template<floating_point T> using soa_vector3 = soa_array<vector<3, T>>;
+    template<floating_point T> using soa_vector4 = soa_array<vector<4, T>>;
+    template<floating_point T> using soa_quaternion = soa_array<quaternion<T>>;
+
+    namespace internal {
+        // out = mat * (in, 1) over raw lanes, restrict lets the compiler vectorize without runtime overlap checks
+        template<floating_point T>
+        fn soa_transform(T const *__restrict x,
+                         T const *__restrict y,
+                         T const *__restrict z,
+                         T *__restrict       ox,
+                         T *__restrict       oy,
+                         T *__restrict       oz,
+                         core::usize         count,
+                         matrix<4, 4, T> const &mat) -> void {
+            auto const m00 = mat[0][0], m10 = mat[1][0], m20 = mat[2][0], m30 = mat[3][0];
+            auto const m01 = mat[0][1], m11 = mat[1][1], m21 = mat[2][1], m31 = mat[3][1];
+            auto const m02 = mat[0][2], m12 = mat[1][2], m22 = mat[2][2], m32 = mat[3][2];
+
+            for (core::usize i = 0; i < count; ++i) {
+                auto const px = x[i];
+                auto const py = y[i];
+                auto const pz = z[i];
+                ox[i] = m00 * px + m10 * py + m20 * pz + m30;
+                oy[i] = m01 * px + m11 * py + m21 * pz + m31;
+                oz[i] = m02 * px + m12 * py + m22 * pz + m32;
+            }
+        }
+
+        // out = mat * in over raw lanes, a pure rotation has no translation column to add
+        template<floating_point T>
+        fn soa_transform(T const *__restrict x,
+                         T const *__restrict y,
+                         T const *__restrict z,
+                         T *__restrict       ox,
+                         T *__restrict       oy,
+                         T *__restrict       oz,
+                         core::usize         count,
+                         matrix<3, 3, T> const &mat) -> void {
+            auto const m00 = mat[0][0], m10 = mat[1][0], m20 = mat[2][0];
+            auto const m01 = mat[0][1], m11 = mat[1][1], m21 = mat[2][1];
+            auto const m02 = mat[0][2], m12 = mat[1][2], m22 = mat[2][2];
+
+            for (core::usize i = 0; i < count; ++i) {
+                auto const px = x[i];
+                auto const py = y[i];
+                auto const pz = z[i];
+                ox[i] = m00 * px + m10 * py + m20 * pz;
+                oy[i] = m01 * px + m11 * py + m21 * pz;
+                oz[i] = m02 * px + m12 * py + m22 * pz;
+            }
+        }
+
+        // out = quat * in * quat^-1 over raw lanes for a unit quaternion, evaluated as in + s * t + u x t with
+        // t = 2 (u x in), which is the sandwich product with the terms that cancel left out
+        template<floating_point T>
+        fn soa_transform(T const *__restrict x,
+                         T const *__restrict y,
+                         T const *__restrict z,
+                         T *__restrict       ox,
+                         T *__restrict       oy,
+                         T *__restrict       oz,
+                         core::usize         count,
+                         quaternion<T> const &quat) -> void {
+            auto const qs = quat.s, qx = quat.x, qy = quat.y, qz = quat.z;
+
+            for (core::usize i = 0; i < count; ++i) {
+                auto const px = x[i];
+                auto const py = y[i];
+                auto const pz = z[i];
+                auto const tx = static_cast<T>(2) * (qy * pz - qz * py);
+                auto const ty = static_cast<T>(2) * (qz * px - qx * pz);
+                auto const tz = static_cast<T>(2) * (qx * py - qy * px);
+                ox[i] = px + qs * tx + (qy * tz - qz * ty);
+                oy[i] = py + qs * ty + (qz * tx - qx * tz);
+                oz[i] = pz + qs * tz + (qx * ty - qy * tx);
+            }
+        }
+
+        // out = quat * in over raw lanes
+        template<floating_point T>
+        fn soa_multiply(T const *__restrict s,
+                        T const *__restrict x,
+                        T const *__restrict y,
+                        T const *__restrict z,
+                        T *__restrict       os,
+                        T *__restrict       ox,
+                        T *__restrict       oy,
+                        T *__restrict       oz,
+                        core::usize         count,
+                        quaternion<T> const &quat) -> void {
+            auto const rs = quat.s, rx = quat.x, ry = quat.y, rz = quat.z;
+
+            for (core::usize i = 0; i < count; ++i) {
+                auto const qs = s[i];
+                auto const qx = x[i];
+                auto const qy = y[i];
+                auto const qz = z[i];
+                os[i] = rs * qs - rx * qx - ry * qy - rz * qz;
+                ox[i] = rs * qx + rx * qs + ry * qz - rz * qy;
+                oy[i] = rs * qy + ry * qs + rz * qx - rx * qz;
+                oz[i] = rs * qz + rz * qs + rx * qy - ry * qx;
+            }
+        }
+
+        // calls kernel(inputs, outputs, count) for each block of an array, when in and out are the same array every
+        // block is first staged into a small aligned buffer so the kernel's restrict contract still holds
+        template<typename E, typename Kernel>
+        fn soa_apply(soa_array<E> const &in, soa_array<E> &out, Kernel &&kernel) -> void {
+            using T = typename E::value_type;
+            constexpr auto lanes = soa_array<E>::lanes;
+            constexpr auto block = core::usize{256};
+
+            auto const count = in.size();
+            if (&in != &out) {
+                out.resize(count);
+
+                std::array<T const *, lanes> src{};
+                std::array<T *, lanes>       dst{};
+                for (core::usize l = 0; l < lanes; ++l) {
+                    src[l] = in.lane(l);
+                    dst[l] = out.lane(l);
+                }
+                kernel(src, dst, count);
+                return;
+            }
+
+            alignas(soa_alignment) T staged[lanes][block];
+            for (core::usize first = 0; first < count; first += block) {
+                auto const size = min(block, count - first);
+
+                std::array<T const *, lanes> src{};
+                std::array<T *, lanes>       dst{};
+                for (core::usize l = 0; l < lanes; ++l) {
+                    std::copy_n(out.lane(l) + first, size, staged[l]);
+                    src[l] = staged[l];
+                    dst[l] = out.lane(l) + first;
+                }
+                kernel(src, dst, size);
+            }
+        }
+    }
+
+    // bulk kernels, every loop runs over plain contiguous lanes so the compiler vectorizes it at the widest width the
+    // build targets, out may be the same array as in
+
+    // out[i] = mat * (in[i], 1)
+    template<floating_point T>
+    fn transform(soa_array<vector<3, T>> const &in, matrix<4, 4, T> const &mat, soa_array<vector<3, T>> &out) -> void {
+        internal::soa_apply(in, out, [&](auto const &src, auto const &dst, core::usize count) {
+            internal::soa_transform(src[0], src[1], src[2], dst[0], dst[1], dst[2], count, mat);
+        });
+    }
+
+    template<floating_point T>
+    fn transform(soa_array<vector<3, T>> const &in, affine3x4<T> const &aff, soa_array<vector<3, T>> &out) -> void { transform(in, aff.to_matrix4x4(), out); }
+
+    // out[i] = mat * in[i]
+    template<floating_point T>
+    fn transform(soa_array<vector<3, T>> const &in, matrix<3, 3, T> const &mat, soa_array<vector<3, T>> &out) -> void {
+        internal::soa_apply(in, out, [&](auto const &src, auto const &dst, core::usize count) {
+            internal::soa_transform(src[0], src[1], src[2], dst[0], dst[1], dst[2], count, mat);
+        });
+    }
+
+    // out[i] = quat * in[i] * quat^-1 evaluated per point, rotate() below is the cheaper way to apply a quaternion
+    template<floating_point T>
+    fn sandwich(soa_array<vector<3, T>> const &in, quaternion<T> const &quat, soa_array<vector<3, T>> &out) -> void {
+        auto const unit = normalize(quat);
+        internal::soa_apply(in, out, [&](auto const &src, auto const &dst, core::usize count) {
+            internal::soa_transform(src[0], src[1], src[2], dst[0], dst[1], dst[2], count, unit);
+        });
+    }
+
+    // out[i] = quat * in[i] * quat^-1, the quaternion is expanded to a 3x3 once, 9 multiply-adds per point instead of ~18
+    template<floating_point T>
+    fn rotate(soa_array<vector<3, T>> const &in, quaternion<T> const &quat, soa_array<vector<3, T>> &out) -> void {
+        transform(in, matrix<4, 4, T>::from_quaternion(normalize(quat)), out);
+    }
+
+    // out[i] = quat * in[i], composing every stored rotation with the same one
+    template<floating_point T>
+    fn multiply(quaternion<T> const &quat, soa_array<quaternion<T>> const &in, soa_array<quaternion<T>> &out) -> void {
+        internal::soa_apply(in, out, [&](auto const &src, auto const &dst, core::usize count) {
+            internal::soa_multiply(src[0], src[1], src[2], src[3], dst[0], dst[1], dst[2], dst[3], count, quat);
+        });
+    }
+
+    template<typename E>
+    fn dot(soa_array<E> const &a, soa_array<E> const &b, std::vector<typename E::value_type> &out) -> void {
+        assert(a.size() == b.size());
+        auto const count = a.size();
+        out.assign(count, static_cast<typename E::value_type>(0));
+
+        typename E::value_type *__restrict result = out.data();
+        for (core::usize l = 0; l < soa_array<E>::lanes; ++l) {
+            typename E::value_type const *__restrict u = a.lane(l);
+            typename E::value_type const *__restrict v = b.lane(l);
+            for (core::usize i = 0; i < count; ++i)
+                result[i] += u[i] * v[i];
+        }
+    }
+
+    template<typename E>
+    fn normalize(soa_array<E> &array) -> void {
+        using T = typename E::value_type;
+
+        auto const     count = array.size();
+        std::vector<T> inverseLength(count, static_cast<T>(0));
+
+        T *__restrict length = inverseLength.data();
+        for (core::usize l = 0; l < soa_array<E>::lanes; ++l) {
+            T const *__restrict v = array.lane(l);
+            for (core::usize i = 0; i < count; ++i)
+                length[i] += v[i] * v[i];
+        }
+        for (core::usize i = 0; i < count; ++i)
+            length[i] = static_cast<T>(1) / sqrt(length[i]);
+
+        for (core::usize l = 0; l < soa_array<E>::lanes; ++l) {
+            T *__restrict v = array.lane(l);
+            for (core::usize i = 0; i < count; ++i)
+                v[i] *= length[i];
+        }
+    }
+
+    // component-wise minimum and maximum over all elements
+    template<typename E>
+    fn bounds(soa_array<E> const &array) -> std::pair<E, E> {
+        E lo{};
+        E hi{};
+        for (core::usize l = 0; l < soa_array<E>::lanes; ++l) {
+            auto const [min_, max_] = internal::lane_bounds<typename E::value_type>::compute(array.lane(l), array.size());
+            lo[l] = min_;
+            hi[l] = max_;
+        }
+        return {lo, hi};
+    }
+
+    template<typename E>
+    fn min(soa_array<E> const &array) -> E { return bounds(array).first; }
+
+    template<typename E>
+    fn max(soa_array<E> const &array) -> E { return bounds(array).second; }
+}
+
+#endif //MICRO_MATHEMATICS_SOA_H
@@ -5,6 +5,10 @@
 #ifndef MICRO_PERFORMANCE_H
 #define MICRO_PERFORMANCE_H
 
+#include "performance/affinity.h"
+#include "performance/cpu.h"
 #include "performance/stopwatch.h"
+#include "performance/suite.h"
+#include "performance/workload.h"
 
 #endif //MICRO_PERFORMANCE_H
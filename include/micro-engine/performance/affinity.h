@@ -0,0 +1,45 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+#ifndef MICRO_PERFORMANCE_AFFINITY_H
+#define MICRO_PERFORMANCE_AFFINITY_H
+
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "../core/types.h"
+
+namespace micro::perf {
+    fn concurrency() -> core::usize {
+        auto const count = std::thread::hardware_concurrency();
+        return count == 0 ? 1 : count;
+    }
+
+    // pins the calling thread to a single logical cpu, returns false where affinity is not supported
+    fn pin(core::usize cpu) -> bool {
+        cpu %= concurrency();
+#if defined(_WIN32)
+        return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{1} << cpu) != 0;
+#elif defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) == 0;
+#else
+        (void)cpu;
+        return false;
+#endif
+    }
+}
+
+#endif //MICRO_PERFORMANCE_AFFINITY_H
@@ -0,0 +1,100 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+#ifndef MICRO_PERFORMANCE_CPU_H
+#define MICRO_PERFORMANCE_CPU_H
+
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define MICRO_PERFORMANCE_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+#include "../core/types.h"
+
+namespace micro::perf {
+    // instruction set extensions the running cpu and operating system both support, detected once at first use
+    struct cpu_features {
+        bool sse2     = false;
+        bool sse41    = false;
+        bool avx      = false;
+        bool avx2     = false;
+        bool fma      = false;
+        bool avx512f  = false;
+        bool avx512vl = false;
+
+        [[nodiscard]] fn toString() const -> std::string {
+            std::string res{};
+            auto const  append = [&](bool enabled, core::cstring name) {
+                if (!enabled)
+                    return;
+                if (!res.empty())
+                    res += ' ';
+                res += name;
+            };
+
+            append(sse2, "sse2");
+            append(sse41, "sse4.1");
+            append(avx, "avx");
+            append(avx2, "avx2");
+            append(fma, "fma");
+            append(avx512f, "avx512f");
+            append(avx512vl, "avx512vl");
+            return res.empty() ? std::string{"none"} : res;
+        }
+    };
+
+    namespace internal {
+        fn detect() -> cpu_features {
+            cpu_features res{};
+#if defined(MICRO_PERFORMANCE_X86) && defined(_MSC_VER) && !defined(__clang__)
+            int info[4];
+            __cpuid(info, 0);
+            auto const maxLeaf = info[0];
+
+            __cpuid(info, 1);
+            res.sse2  = (info[3] & (1 << 26)) != 0;
+            res.sse41 = (info[2] & (1 << 19)) != 0;
+            res.fma   = (info[2] & (1 << 12)) != 0;
+
+            // the os has to save the ymm (and zmm) state on context switches, or the instructions fault
+            auto const osxsave = (info[2] & (1 << 27)) != 0;
+            auto const xcr0    = osxsave ? _xgetbv(0) : 0;
+            auto const ymm     = (xcr0 & 0x6) == 0x6;
+            auto const zmm     = (xcr0 & 0xe6) == 0xe6;
+
+            res.avx = ymm && (info[2] & (1 << 28)) != 0;
+            res.fma = res.fma && ymm;
+
+            if (maxLeaf >= 7) {
+                __cpuidex(info, 7, 0);
+                res.avx2     = ymm && (info[1] & (1 << 5)) != 0;
+                res.avx512f  = zmm && (info[1] & (1 << 16)) != 0;
+                res.avx512vl = zmm && (info[1] & (1 << 31)) != 0;
+            }
+#elif defined(MICRO_PERFORMANCE_X86) && (defined(__GNUC__) || defined(__clang__))
+            // the builtins already account for the os saving the extended register state
+            __builtin_cpu_init();
+            res.sse2     = __builtin_cpu_supports("sse2");
+            res.sse41    = __builtin_cpu_supports("sse4.1");
+            res.avx      = __builtin_cpu_supports("avx");
+            res.avx2     = __builtin_cpu_supports("avx2");
+            res.fma      = __builtin_cpu_supports("fma");
+            res.avx512f  = __builtin_cpu_supports("avx512f");
+            res.avx512vl = __builtin_cpu_supports("avx512vl");
+#endif
+            return res;
+        }
+    }
+
+    fn cpu() -> cpu_features const & {
+        static cpu_features const features = internal::detect();
+        return features;
+    }
+}
+
+#endif //MICRO_PERFORMANCE_CPU_H
@@ -0,0 +1,273 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+#ifndef MICRO_PERFORMANCE_SUITE_H
+#define MICRO_PERFORMANCE_SUITE_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <istream>
+#include <iterator>
+#include <map>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#include "../core/types.h"
+
+namespace micro::perf {
+    // forces the value to be materialized, the compiler has to assume it is read
+    template<typename T>
+    fn do_not_optimize(T const &value) -> void {
+#if defined(_MSC_VER) && !defined(__clang__)
+        static_cast<void>(*static_cast<char const volatile *>(static_cast<void const *>(&value)));
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "r,m"(value) : "memory");
+#endif
+    }
+
+    // the compiler has to assume every reachable memory location was read and written
+    fn clobber() -> void {
+#if defined(_MSC_VER) && !defined(__clang__)
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : : "memory");
+#endif
+    }
+
+    // nanoseconds per operation over the measured repetitions
+    struct statistics {
+        core::f64   min         = 0.;
+        core::f64   max         = 0.;
+        core::f64   mean        = 0.;
+        core::f64   median      = 0.;
+        core::f64   stddev      = 0.;
+        core::usize repetitions = 0;
+        core::usize iterations  = 0;
+    };
+
+    fn summarize(std::vector<core::f64> samples, core::usize iterations) -> statistics {
+        statistics res{};
+        if (samples.empty())
+            return res;
+
+        std::sort(samples.begin(), samples.end());
+
+        auto const count = static_cast<core::f64>(samples.size());
+        auto const mid   = samples.size() / 2;
+
+        res.min         = samples.front();
+        res.max         = samples.back();
+        res.median      = samples.size() % 2 == 0 ? (samples[mid - 1] + samples[mid]) / 2. : samples[mid];
+        res.repetitions = samples.size();
+        res.iterations  = iterations;
+
+        for (auto const sample : samples)
+            res.mean += sample;
+        res.mean /= count;
+
+        for (auto const sample : samples)
+            res.stddev += (sample - res.mean) * (sample - res.mean);
+        res.stddev = samples.size() > 1 ? std::sqrt(res.stddev / (count - 1.)) : 0.;
+        return res;
+    }
+
+    struct suite_options {
+        // untimed repetitions run before measuring, after calibration
+        core::usize warmup = 3;
+        // timed repetitions, each one runs the calibrated number of iterations
+        core::usize repetitions = 15;
+        // iterations per repetition are doubled until one repetition takes at least this long
+        core::f64 minRepetitionNs = 1'000'000.;
+        // only benchmarks whose name contains the filter are run
+        std::string filter{};
+    };
+
+    // result of one benchmark against the stored baseline, both in median nanoseconds per operation
+    struct baseline_comparison {
+        std::string name;
+        core::f64   baseline  = 0.;
+        core::f64   current   = 0.;
+        core::f64   tolerance = 0.;
+
+        [[nodiscard]] fn ratio() const -> core::f64 { return baseline > 0. ? current / baseline : 1.; }
+
+        [[nodiscard]] fn regressed() const -> bool { return ratio() > 1. + tolerance; }
+    };
+
+    class suite {
+    public:
+        struct result {
+            std::string name;
+            statistics  stats;
+        };
+
+        explicit suite(suite_options options_ = {}) : options{std::move(options_)} {}
+
+        // the operation receives the iteration index, so it can cycle through heap-allocated inputs the compiler cannot
+        // see through, whatever it returns is kept alive with do_not_optimize
+        template<typename Op>
+        fn run(std::string const &name, Op &&op) -> void;
+
+        [[nodiscard]] fn results() const -> std::vector<result> const & { return measured; }
+
+        fn print(std::FILE *out = stdout) const -> void;
+
+        fn write_json(std::ostream &os) const -> void;
+
+        // reads the median of every benchmark in a file written by write_json
+        static fn read_json(std::istream &is) -> std::map<std::string, core::f64>;
+
+        // compares medians against the baseline, the default tolerance is overridden per benchmark by exact name,
+        // benchmarks missing from the baseline are skipped
+        [[nodiscard]] fn compare(std::map<std::string, core::f64> const &baseline,
+                                 core::f64                               tolerance,
+                                 std::map<std::string, core::f64> const &overrides = {}) const -> std::vector<baseline_comparison>;
+
+    private:
+        suite_options       options;
+        std::vector<result> measured{};
+
+        template<typename Op>
+        static fn repetition(Op &op, core::usize iterations) -> core::f64;
+    };
+
+    template<typename Op>
+    fn suite::repetition(Op &op, core::usize iterations) -> core::f64 {
+        auto const start = std::chrono::steady_clock::now();
+        for (core::usize i = 0; i < iterations; ++i) {
+            if constexpr (std::is_void_v<decltype(op(i))>)
+                op(i);
+            else
+                do_not_optimize(op(i));
+            clobber();
+        }
+        auto const end = std::chrono::steady_clock::now();
+
+        return static_cast<core::f64>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    template<typename Op>
+    fn suite::run(std::string const &name, Op &&op) -> void {
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos)
+            return;
+
+        core::usize iterations = 1;
+        while (repetition(op, iterations) < options.minRepetitionNs && iterations < (core::usize{1} << 40))
+            iterations *= 2;
+
+        for (core::usize i = 0; i < options.warmup; ++i)
+            repetition(op, iterations);
+
+        std::vector<core::f64> samples(options.repetitions);
+        for (auto &sample : samples)
+            sample = repetition(op, iterations) / static_cast<core::f64>(iterations);
+
+        measured.push_back(result{name, summarize(std::move(samples), iterations)});
+    }
+
+    fn suite::print(std::FILE *out) const -> void {
+        std::fprintf(out, "%-36s %10s %10s %10s %10s %8s %12s\n",
+                     "benchmark", "median ns", "mean ns", "min ns", "max ns", "cv %", "iterations");
+        for (auto const &[name, stats] : measured)
+            std::fprintf(out, "%-36s %10.2f %10.2f %10.2f %10.2f %8.2f %12zu\n",
+                         name.c_str(), stats.median, stats.mean, stats.min, stats.max,
+                         stats.mean > 0. ? 100. * stats.stddev / stats.mean : 0., stats.iterations);
+    }
+
+    fn suite::write_json(std::ostream &os) const -> void {
+        auto const number = [](core::f64 value) {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%.4f", value);
+            return std::string{buffer};
+        };
+
+        os << "{\n  \"unit\": \"ns/op\",\n  \"benchmarks\": [\n";
+        for (core::usize i = 0; i < measured.size(); ++i) {
+            auto const &[name, stats] = measured[i];
+            os << "    {\"name\": \"" << name << '"'
+               << ", \"median\": " << number(stats.median)
+               << ", \"mean\": " << number(stats.mean)
+               << ", \"min\": " << number(stats.min)
+               << ", \"max\": " << number(stats.max)
+               << ", \"stddev\": " << number(stats.stddev)
+               << ", \"repetitions\": " << stats.repetitions
+               << ", \"iterations\": " << stats.iterations
+               << '}' << (i + 1 < measured.size() ? "," : "") << '\n';
+        }
+        os << "  ]\n}\n";
+    }
+
+    // only understands the flat objects write_json produces, names may not contain quotes
+    fn suite::read_json(std::istream &is) -> std::map<std::string, core::f64> {
+        std::string const text{std::istreambuf_iterator<char>{is}, std::istreambuf_iterator<char>{}};
+
+        auto const field = [&](std::string const &object, std::string const &key) -> std::string {
+            auto at = object.find('"' + key + '"');
+            if (at == std::string::npos)
+                return {};
+            at = object.find(':', at);
+            if (at == std::string::npos)
+                return {};
+            at = object.find_first_not_of(" \t\r\n", at + 1);
+            if (at == std::string::npos)
+                return {};
+            if (object[at] == '"') {
+                auto const end = object.find('"', at + 1);
+                return end == std::string::npos ? std::string{} : object.substr(at + 1, end - at - 1);
+            }
+            auto const end = object.find_first_of(",}", at);
+            return object.substr(at, end - at);
+        };
+
+        std::map<std::string, core::f64> res{};
+        auto                             at = text.find("\"benchmarks\"");
+        while (at != std::string::npos) {
+            auto const open = text.find('{', at);
+            if (open == std::string::npos)
+                break;
+            auto const close = text.find('}', open);
+            if (close == std::string::npos)
+                break;
+
+            auto const object = text.substr(open, close - open + 1);
+            auto const name   = field(object, "name");
+            auto const median = field(object, "median");
+            if (!name.empty() && !median.empty())
+                res[name] = std::strtod(median.c_str(), nullptr);
+
+            at = close + 1;
+        }
+        return res;
+    }
+
+    fn suite::compare(std::map<std::string, core::f64> const &baseline,
+                      core::f64                               tolerance,
+                      std::map<std::string, core::f64> const &overrides) const -> std::vector<baseline_comparison> {
+        std::vector<baseline_comparison> res{};
+        for (auto const &[name, stats] : measured) {
+            auto const stored = baseline.find(name);
+            if (stored == baseline.end())
+                continue;
+
+            auto const custom = overrides.find(name);
+            res.push_back(baseline_comparison{
+                name, stored->second, stats.median, custom == overrides.end() ? tolerance : custom->second
+            });
+        }
+        return res;
+    }
+}
+
+#endif //MICRO_PERFORMANCE_SUITE_H
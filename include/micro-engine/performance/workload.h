@@ -0,0 +1,253 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+#ifndef MICRO_PERFORMANCE_WORKLOAD_H
+#define MICRO_PERFORMANCE_WORKLOAD_H
+
+#include <algorithm>
+#include <cmath>
+#include <istream>
+#include <numbers>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../core/types.h"
+#include "../mathematics/euler.h"
+#include "../mathematics/linear.h"
+
+namespace micro::perf {
+    // named rotation inputs for benchmarks, random rotations only cover the average case while the branchy paths
+    // (matrix_to_quaternion's biggest component, normalize on short axes, the antiparallel case of
+    // quaternion(axis1, axis2)) behave very differently on structured input
+    enum class workload : core::u8 {
+        // uniform angles in [-2pi, 2pi] and axes in [-1, 1]^3, the euler triple is drawn independently
+        uniform,
+        // angles of a fraction of a degree around random axes
+        jitter,
+        // a constant step around one fixed axis
+        spin,
+        // random angles around x, y, z, x, ... in turn
+        alternating,
+        // angles within epsilon of pi, the trace of the matrix goes to -1
+        near_pi,
+        // random angles around axes a few orders of magnitude shorter than unit length
+        short_axis,
+        // euler triples whose middle angle is within epsilon of the gimbal lock of the order
+        gimbal_lock,
+        // samples read from a recorded trace, replayed in order
+        trace
+    };
+
+    inline constexpr workload workloads[]{
+        workload::uniform, workload::jitter, workload::spin, workload::alternating,
+        workload::near_pi, workload::short_axis, workload::gimbal_lock, workload::trace
+    };
+
+    constexpr fn name(workload kind) -> core::cstring {
+        switch (kind) {
+            default:
+            case workload::uniform: return "uniform";
+            case workload::jitter: return "jitter";
+            case workload::spin: return "spin";
+            case workload::alternating: return "alternating";
+            case workload::near_pi: return "near pi";
+            case workload::short_axis: return "short axis";
+            case workload::gimbal_lock: return "gimbal lock";
+            case workload::trace: return "trace";
+        }
+    }
+
+    // one rotation in both forms the application consumes, the euler triple is expressed in the order it is tagged with,
+    // the form the workload targets is kept exactly as generated (the axis is not normalized) and the other is derived
+    struct rotation_sample {
+        math::vector3<core::f32> euler{0.f};
+        math::euler_order        order = math::euler_order::xyz;
+        core::f32                angle = 0.f;
+        math::vector3<core::f32> axis{1.f, 0.f, 0.f};
+
+        [[nodiscard]] fn to_quaternion() const -> math::quaternion<core::f32> { return math::quaternion<core::f32>::from_rotation(angle, axis); }
+
+        // the euler triple in another order is derived from the axis-angle, which does not depend on one
+        [[nodiscard]] fn euler_in(math::euler_order target) const -> math::vector3<core::f32> {
+            if (target == order)
+                return euler;
+
+            auto const mat = math::matrix3x3<core::f32>::from_quaternion(to_quaternion());
+            return math::with_euler_order(target, [&](auto o) { return math::vector3<core::f32>::from_euler<decltype(o)::value>(mat); });
+        }
+    };
+
+    struct workload_options {
+        core::u32         seed  = 20'261'019;
+        math::euler_order order = math::euler_order::xyz;
+        // largest angle of jitter
+        core::f32 jitter = math::radians(.5f);
+        // angle added on every spin step
+        core::f32 spinStep = math::radians(1.f);
+        // largest distance from pi or from the gimbal lock
+        core::f32 epsilon = 1.e-3f;
+    };
+
+    namespace internal {
+        fn sample_from_axis_angle(core::f32 angle, math::vector3<core::f32> const &axis, math::euler_order order) -> rotation_sample {
+            auto const mat = math::matrix3x3<core::f32>::from_quaternion(math::quaternion<core::f32>::from_rotation(angle, axis));
+
+            rotation_sample res{};
+            res.angle = angle;
+            res.axis  = axis;
+            res.order = order;
+            res.euler = math::with_euler_order(order, [&](auto o) { return math::vector3<core::f32>::from_euler<decltype(o)::value>(mat); });
+            return res;
+        }
+
+        fn sample_from_euler(math::vector3<core::f32> const &euler, math::euler_order order) -> rotation_sample {
+            auto const quat = math::with_euler_order(order, [&](auto o) { return math::quaternion<core::f32>::from_euler<decltype(o)::value>(euler); });
+            auto const axis = math::vector3<core::f32>{quat.x, quat.y, quat.z};
+
+            rotation_sample res{};
+            res.euler = euler;
+            res.order = order;
+            if (math::magnitude(axis) > 1.e-7f) {
+                res.angle = 2.f * math::acos(math::clamp(quat.s, -1.f, 1.f));
+                res.axis  = axis;
+            }
+            return res;
+        }
+    }
+
+    class workload_generator {
+    public:
+        explicit workload_generator(workload kind_ = workload::uniform, workload_options options_ = {})
+            : kind{kind_}, options{options_}, engine{options_.seed} {}
+
+        // replays the recorded samples in order, wrapping around at the end
+        explicit workload_generator(std::vector<rotation_sample> trace_, workload_options options_ = {})
+            : kind{workload::trace}, options{options_}, engine{options_.seed}, recorded{std::move(trace_)} {}
+
+        [[nodiscard]] fn workload_kind() const -> workload { return kind; }
+
+        fn next() -> rotation_sample;
+
+        fn take(core::usize count) -> std::vector<rotation_sample> {
+            std::vector<rotation_sample> res{};
+            res.reserve(count);
+            for (core::usize i = 0; i < count; ++i)
+                res.push_back(next());
+            return res;
+        }
+
+    private:
+        workload                     kind;
+        workload_options             options;
+        std::mt19937                 engine;
+        std::vector<rotation_sample> recorded{};
+        core::usize                  index = 0;
+
+        fn uniform(core::f32 lo, core::f32 hi) -> core::f32 { return std::uniform_real_distribution<core::f32>{lo, hi}(engine); }
+
+        fn direction() -> math::vector3<core::f32> {
+            math::vector3<core::f32> res{0.f};
+            while (math::magnitude(res) < 1.e-3f)
+                res = math::vector3<core::f32>{uniform(-1.f, 1.f), uniform(-1.f, 1.f), uniform(-1.f, 1.f)};
+            return math::normalize(res);
+        }
+    };
+
+    fn workload_generator::next() -> rotation_sample {
+        constexpr auto pi = std::numbers::pi_v<core::f32>;
+
+        auto const step = index++;
+        switch (kind) {
+            default:
+            case workload::uniform: {
+                auto const angle = uniform(-2.f * pi, 2.f * pi);
+                auto       axis  = math::vector3<core::f32>{uniform(-1.f, 1.f), uniform(-1.f, 1.f), uniform(-1.f, 1.f)};
+                if (axis == math::vector3<core::f32>{0.f})
+                    axis = math::vector3<core::f32>{1.f, 0.f, 0.f};
+
+                auto res  = internal::sample_from_axis_angle(angle, axis, options.order);
+                res.euler = math::vector3<core::f32>{uniform(-2.f * pi, 2.f * pi), uniform(-2.f * pi, 2.f * pi), uniform(-2.f * pi, 2.f * pi)};
+                return res;
+            }
+            case workload::jitter:
+                return internal::sample_from_axis_angle(uniform(-options.jitter, options.jitter), direction(), options.order);
+            case workload::spin:
+                return internal::sample_from_axis_angle(options.spinStep, math::vector3<core::f32>{0.f, 1.f, 0.f}, options.order);
+            case workload::alternating: {
+                math::vector3<core::f32> axis{0.f};
+                axis[step % 3] = 1.f;
+                return internal::sample_from_axis_angle(uniform(-pi, pi), axis, options.order);
+            }
+            case workload::near_pi:
+                return internal::sample_from_axis_angle(pi - uniform(0.f, options.epsilon), direction(), options.order);
+            case workload::short_axis:
+                return internal::sample_from_axis_angle(uniform(-pi, pi), direction() * std::pow(10.f, uniform(-6.f, -2.f)), options.order);
+            case workload::gimbal_lock: {
+                // tait-bryan orders lock at a middle angle of +-pi/2, proper euler orders at 0 and pi
+                auto const proper = math::with_euler_order(options.order, [](auto o) { return math::internal::euler_axes<decltype(o)::value>::proper; });
+                auto const lock   = proper
+                                        ? (uniform(0.f, 1.f) < .5f ? 0.f : pi)
+                                        : (uniform(0.f, 1.f) < .5f ? -pi / 2.f : pi / 2.f);
+                return internal::sample_from_euler(
+                    math::vector3<core::f32>{uniform(-pi, pi), lock + uniform(-options.epsilon, options.epsilon), uniform(-pi, pi)},
+                    options.order
+                );
+            }
+            case workload::trace:
+                return recorded.empty() ? rotation_sample{} : recorded[step % recorded.size()];
+        }
+    }
+
+    // one sample per line, either "alpha,beta,gamma" XYZ euler angles or "angle,x,y,z" axis-angle (radians), blank
+    // lines and lines starting with '#' are skipped, the samples are kept in XYZ order and re-expressed by euler_in
+    template<typename OnError>
+    fn read_trace(std::istream &is, OnError &&onError) -> std::vector<rotation_sample> {
+        std::vector<rotation_sample> res{};
+
+        std::string line;
+        core::usize lineNumber = 0;
+        while (std::getline(is, line)) {
+            ++lineNumber;
+
+            auto const first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos || line[first] == '#')
+                continue;
+
+            std::replace(line.begin(), line.end(), ',', ' ');
+            std::istringstream iss{line};
+
+            std::vector<core::f32> values{};
+            core::f32              value;
+            while (iss >> value)
+                values.push_back(value);
+
+            if (values.size() == 3)
+                res.push_back(internal::sample_from_euler(math::vector3<core::f32>{values[0], values[1], values[2]}, math::euler_order::xyz));
+            else if (values.size() == 4 && math::vector3<core::f32>{values[1], values[2], values[3]} != math::vector3<core::f32>{0.f})
+                res.push_back(internal::sample_from_axis_angle(values[0], math::vector3<core::f32>{values[1], values[2], values[3]}, math::euler_order::xyz));
+            else {
+                std::ostringstream oss{};
+                oss << "Skipping malformed rotation on line " << lineNumber;
+                onError(oss.str());
+            }
+        }
+
+        return res;
+    }
+
+    // writes the axis-angle form read_trace understands, with enough digits to read back the same floats
+    fn write_trace(std::ostream &os, std::vector<rotation_sample> const &samples) -> void {
+        auto const precision = os.precision(9);
+        os << "# angle,x,y,z (radians)\n";
+        for (auto const &sample : samples)
+            os << sample.angle << ',' << sample.axis.x << ',' << sample.axis.y << ',' << sample.axis.z << '\n';
+        os.precision(precision);
+    }
+}
+
+#endif //MICRO_PERFORMANCE_WORKLOAD_H
@@ -9,6 +9,10 @@
 #include "utils/conversion.h"
 #include "utils/image.h"
 #include "utils/log.h"
+#include "utils/mapped-file.h"
+#include "utils/mesh-cache.h"
+#include "utils/mesh-optimize.h"
+#include "utils/mesh-simplify.h"
 #include "utils/object.h"
 #include "utils/time.h"
 
@@ -0,0 +1,162 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+#ifndef MICRO_UTILS_MAPPED_FILE_H
+#define MICRO_UTILS_MAPPED_FILE_H
+
+#include <string_view>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "../core/types.h"
+
+namespace micro::utils {
+    // read-only view of a whole file mapped into memory, the pages are loaded on first touch, an empty file or one
+    // that could not be opened maps to an empty view
+    class mapped_file {
+    public:
+        mapped_file() = default;
+
+        explicit mapped_file(core::cstring path);
+
+        mapped_file(mapped_file const &) = delete;
+
+        fn operator=(mapped_file const &) -> mapped_file & = delete;
+
+        mapped_file(mapped_file &&file) noexcept;
+
+        fn operator=(mapped_file &&file) noexcept -> mapped_file &;
+
+        ~mapped_file();
+
+        [[nodiscard]] fn data() const -> char const * { return address; }
+
+        [[nodiscard]] fn size() const -> core::usize { return length; }
+
+        [[nodiscard]] fn view() const -> std::string_view { return {address, length}; }
+
+        // false only when the file could not be opened or mapped, an empty file is still open
+        [[nodiscard]] fn is_open() const -> bool { return opened; }
+
+        fn close() -> void;
+
+    private:
+        char const *address = nullptr;
+        core::usize length  = 0;
+        bool        opened  = false;
+    };
+
+    mapped_file::mapped_file(core::cstring path) {
+#if defined(_WIN32)
+        auto const file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return;
+
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(file, &fileSize)) {
+            CloseHandle(file);
+            return;
+        }
+
+        opened = true;
+        if (fileSize.QuadPart == 0) {
+            CloseHandle(file);
+            return;
+        }
+
+        auto const mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (mapping == nullptr) {
+            opened = false;
+            return;
+        }
+
+        address = static_cast<char const *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        CloseHandle(mapping);
+        if (address == nullptr) {
+            opened = false;
+            return;
+        }
+        length = static_cast<core::usize>(fileSize.QuadPart);
+#else
+        auto const file = ::open(path, O_RDONLY);
+        if (file < 0)
+            return;
+
+        struct stat info{};
+        if (::fstat(file, &info) != 0) {
+            ::close(file);
+            return;
+        }
+
+        opened = true;
+        if (info.st_size == 0) {
+            ::close(file);
+            return;
+        }
+
+        auto *const mapping = ::mmap(nullptr, static_cast<core::usize>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        ::close(file);
+        if (mapping == MAP_FAILED) {
+            opened = false;
+            return;
+        }
+
+        // the file is scanned front to back once
+        ::madvise(mapping, static_cast<core::usize>(info.st_size), MADV_SEQUENTIAL);
+
+        address = static_cast<char const *>(mapping);
+        length  = static_cast<core::usize>(info.st_size);
+#endif
+    }
+
+    mapped_file::mapped_file(mapped_file &&file) noexcept
+        : address{std::exchange(file.address, nullptr)},
+          length{std::exchange(file.length, 0)},
+          opened{std::exchange(file.opened, false)} {}
+
+    fn mapped_file::operator=(mapped_file &&file) noexcept -> mapped_file & {
+        if (this == &file)
+            return *this;
+
+        close();
+        address = std::exchange(file.address, nullptr);
+        length  = std::exchange(file.length, 0);
+        opened  = std::exchange(file.opened, false);
+
+        return *this;
+    }
+
+    mapped_file::~mapped_file() { close(); }
+
+    fn mapped_file::close() -> void {
+        if (address != nullptr) {
+#if defined(_WIN32)
+            UnmapViewOfFile(address);
+#else
+            ::munmap(const_cast<char *>(address), length);
+#endif
+        }
+
+        address = nullptr;
+        length  = 0;
+        opened  = false;
+    }
+}
+
+#endif //MICRO_UTILS_MAPPED_FILE_H
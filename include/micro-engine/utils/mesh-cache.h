@@ -0,0 +1,335 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+#ifndef MICRO_UTILS_MESH_CACHE_H
+#define MICRO_UTILS_MESH_CACHE_H
+
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "../core/types.h"
+#include "../graphics/bounding-box.h"
+#include "../graphics/meshlet.h"
+#include "../graphics/vertex.h"
+#include "mapped-file.h"
+#include "mesh-optimize.h"
+#include "mesh-simplify.h"
+#include "object.h"
+
+namespace micro::obj {
+    // what is done to the parsed arrays before they are cached, every set of options is cached in a file of its own
+    struct mesh_options {
+        // reorder the triangles for the post-transform cache and the vertices by first use
+        bool optimize = false;
+        // append a simplified level for every fraction after the full one, none when empty
+        std::span<core::f32 const> lodFractions{};
+    };
+
+    namespace internal {
+        inline constexpr char          cache_magic[8] = {'M', 'I', 'C', 'R', 'O', 'M', 'S', 'H'};
+        inline constexpr std::uint32_t cache_version  = 3;
+        // arrays start on cache line boundaries, the mapping itself is page aligned
+        inline constexpr std::size_t cache_alignment = 64;
+
+        // fixed-size header of a cache file, followed by the vertices, the indices and then the first index and index
+        // count of every level of detail
+        struct cache_header {
+            char          magic[8];
+            std::uint32_t version;
+            // the layout the arrays were written with, a load with another vertex layout or index type rewrites them
+            std::uint32_t vertexSize;
+            std::uint32_t indexSize;
+            std::uint32_t vertexLayout;
+            // the mesh_options the arrays were processed with
+            std::uint32_t options;
+            std::uint64_t sourceSize;
+            std::int64_t  sourceTime;
+            std::uint64_t contentHash;
+            std::uint64_t vertexCount;
+            std::uint64_t indexCount;
+            std::uint64_t levelCount;
+            core::f32     box[6];
+            // acmr and atvr of the full level in file order and as stored
+            core::f32     cacheStatistics[4];
+        };
+
+        constexpr fn align_up(std::size_t offset) -> std::size_t { return (offset + cache_alignment - 1) / cache_alignment * cache_alignment; }
+
+        constexpr fn vertices_offset() -> std::size_t { return align_up(sizeof(cache_header)); }
+
+        constexpr fn indices_offset(std::uint64_t vertexCount, std::size_t vertexSize) -> std::size_t { return align_up(vertices_offset() + vertexCount * vertexSize); }
+
+        constexpr fn levels_offset(std::uint64_t vertexCount, std::size_t vertexSize, std::uint64_t indexCount, std::size_t indexSize) -> std::size_t {
+            return align_up(indices_offset(vertexCount, vertexSize) + indexCount * indexSize);
+        }
+
+        // fnv-1a over the flag, the level count and the bits of every fraction, part of the file name and the header
+        fn options_signature(mesh_options const &options) -> std::uint32_t {
+            std::uint32_t res = 2'166'136'261u;
+            for (auto const value : {static_cast<std::uint32_t>(options.optimize), static_cast<std::uint32_t>(options.lodFractions.size())})
+                res = (res ^ value) * 16'777'619u;
+            for (auto const fraction : options.lodFractions)
+                res = (res ^ std::bit_cast<std::uint32_t>(fraction)) * 16'777'619u;
+            return res;
+        }
+
+        // 64-bit multiply-xorshift over 8-byte words, only has to tell edited files apart, not resist crafted ones
+        fn content_hash(std::string_view bytes) -> std::uint64_t {
+            constexpr std::uint64_t multiplier = 0x9e3779b97f4a7c15ull;
+
+            std::uint64_t h = 0xcbf29ce484222325ull ^ bytes.size();
+            std::size_t   i = 0;
+            for (; i + 8 <= bytes.size(); i += 8) {
+                std::uint64_t word;
+                std::memcpy(&word, bytes.data() + i, sizeof(word));
+                h = (h ^ word) * multiplier;
+                h ^= h >> 29;
+            }
+
+            std::uint64_t tail = 0;
+            std::memcpy(&tail, bytes.data() + i, bytes.size() - i);
+            h = (h ^ tail) * multiplier;
+            return h ^ (h >> 32);
+        }
+    }
+
+    // the loaded arrays, either read straight from a mapped cache file or owned after parsing and processing the source
+    template<std::unsigned_integral T, graphics::vertex_layout V = graphics::Vertex>
+    class cached_mesh {
+    public:
+        [[nodiscard]] fn vertices() const -> std::span<V const> {
+            return mapping.is_open()
+                       ? std::span{reinterpret_cast<V const *>(mapping.data() + internal::vertices_offset()), vertexCount}
+                       : std::span<V const>{parsedVertices};
+        }
+
+        [[nodiscard]] fn indices() const -> std::span<T const> {
+            return mapping.is_open()
+                       ? std::span{reinterpret_cast<T const *>(mapping.data() + internal::indices_offset(vertexCount, sizeof(V))), indexCount}
+                       : std::span<T const>{parsedIndices};
+        }
+
+        // the full level first, a single level covering every index when none were built
+        [[nodiscard]] fn levels() const -> std::span<graphics::IndexRange const> { return ranges; }
+
+        [[nodiscard]] fn box() const -> graphics::BoundingBox const & { return boundingBox; }
+
+        // post-transform cache behaviour of the full level in file order and as processed
+        [[nodiscard]] fn source_statistics() const -> vertex_cache_statistics const & { return sourceStatistics; }
+
+        [[nodiscard]] fn statistics() const -> vertex_cache_statistics const & { return processedStatistics; }
+
+        // true when the arrays come from the cache instead of parsing the source
+        [[nodiscard]] fn cached() const -> bool { return mapping.is_open(); }
+
+        static fn load(core::cstring                              path,
+                       std::filesystem::path const &              directory,
+                       core::Consumer<std::string const &> const &onError,
+                       load_progress *                            progress,
+                       mesh_options const &                       options) -> cached_mesh;
+
+    private:
+        // returns false when the load was cancelled
+        fn process(mesh_options const &options, load_progress *progress) -> bool;
+
+        utils::mapped_file                mapping{};
+        core::usize                       vertexCount = 0;
+        core::usize                       indexCount  = 0;
+        std::vector<V>                    parsedVertices{};
+        std::vector<T>                    parsedIndices{};
+        std::vector<graphics::IndexRange> ranges{};
+        graphics::BoundingBox             boundingBox{};
+        vertex_cache_statistics           sourceStatistics{};
+        vertex_cache_statistics           processedStatistics{};
+    };
+
+    // loads through a binary cache in the given directory, one file per source path, vertex layout and set of options,
+    // which is reused while the source keeps its size, modification time and content hash, and rewritten after parsing
+    // and processing otherwise, so a hit skips both, cache failures only cost the parse, a cancelled load returns an
+    // empty mesh and writes nothing
+    template<std::unsigned_integral T, graphics::vertex_layout V = graphics::Vertex>
+    fn load_cached(core::cstring                              path,
+                   std::filesystem::path const &              directory,
+                   core::Consumer<std::string const &> const &onError  = [](auto const &) {},
+                   load_progress *                            progress = nullptr,
+                   mesh_options const &                       options  = {}) -> cached_mesh<T, V> {
+        return cached_mesh<T, V>::load(path, directory, onError, progress, options);
+    }
+
+    // the reordering and levels of detail of the options, each level is reordered for the cache on its own, the
+    // progress restarts for the levels of detail and its stage says so
+    template<std::unsigned_integral T, graphics::vertex_layout V>
+    fn cached_mesh<T, V>::process(mesh_options const &options, load_progress *progress) -> bool {
+        auto const cancelled = [&]() { return progress != nullptr && progress->is_cancelled(); };
+        if (progress != nullptr)
+            progress->stage.store(load_stage::processing, std::memory_order_relaxed);
+
+        sourceStatistics = analyze_vertex_cache(std::span<T const>{parsedIndices}, parsedVertices.size());
+        if (options.optimize) {
+            parsedIndices  = optimize_vertex_cache(std::span<T const>{parsedIndices}, parsedVertices.size());
+            parsedVertices = optimize_vertex_fetch(std::span<V const>{parsedVertices}, parsedIndices);
+        }
+        processedStatistics = analyze_vertex_cache(std::span<T const>{parsedIndices}, parsedVertices.size());
+
+        ranges = options.lodFractions.empty()
+                     ? std::vector<graphics::IndexRange>{graphics::IndexRange{0, parsedIndices.size()}}
+                     : build_lod_chain(std::span<V const>{parsedVertices}, parsedIndices, options.lodFractions, progress);
+        for (core::usize level = 1; options.optimize && level < ranges.size() && !cancelled(); ++level) {
+            auto const range     = ranges[level];
+            auto const reordered = optimize_vertex_cache(std::span<T const>{parsedIndices}.subspan(range.first, range.count), parsedVertices.size());
+            std::copy(reordered.begin(), reordered.end(), parsedIndices.begin() + static_cast<std::ptrdiff_t>(range.first));
+        }
+
+        return !cancelled();
+    }
+
+    template<std::unsigned_integral T, graphics::vertex_layout V>
+    fn cached_mesh<T, V>::load(core::cstring                              path,
+                            std::filesystem::path const &              directory,
+                            core::Consumer<std::string const &> const &onError,
+                            load_progress *                            progress,
+                            mesh_options const &                       options) -> cached_mesh {
+        cached_mesh mesh{};
+
+        std::error_code error{};
+        auto const      source     = std::filesystem::weakly_canonical(path, error);
+        auto const      sourceSize = std::filesystem::file_size(source, error);
+        auto const      sourceTime = std::filesystem::last_write_time(source, error).time_since_epoch().count();
+        if (error) {
+            onError("Unable to open the file!");
+            return mesh;
+        }
+
+        std::uint64_t contentHash = 0;
+        {
+            utils::mapped_file file{source.string().c_str()};
+            contentHash = internal::content_hash(file.view());
+        }
+
+        auto const layout    = graphics::layout_signature<V>();
+        auto const processed = internal::options_signature(options);
+
+        char name[48];
+        std::snprintf(name, sizeof(name), "%016llx-%08x-%08x.mesh",
+                      static_cast<unsigned long long>(internal::content_hash(source.string())), static_cast<unsigned>(layout),
+                      static_cast<unsigned>(processed));
+        auto const cachePath = directory / name;
+
+        if (utils::mapped_file file{cachePath.string().c_str()}; file.size() >= sizeof(internal::cache_header)) {
+            internal::cache_header header{};
+            std::memcpy(&header, file.data(), sizeof(header));
+
+            auto const valid = std::memcmp(header.magic, internal::cache_magic, sizeof(header.magic)) == 0 &&
+                               header.version == internal::cache_version &&
+                               header.vertexSize == sizeof(V) &&
+                               header.indexSize == sizeof(T) &&
+                               header.vertexLayout == layout &&
+                               header.options == processed &&
+                               header.sourceSize == sourceSize &&
+                               header.sourceTime == static_cast<std::int64_t>(sourceTime) &&
+                               header.contentHash == contentHash &&
+                               header.levelCount > 0 &&
+                               file.size() >= internal::levels_offset(header.vertexCount, sizeof(V), header.indexCount, sizeof(T)) +
+                                                  header.levelCount * 2 * sizeof(std::uint64_t);
+            if (valid) {
+                mesh.vertexCount = static_cast<core::usize>(header.vertexCount);
+                mesh.indexCount  = static_cast<core::usize>(header.indexCount);
+
+                std::vector<std::uint64_t> levels(2 * header.levelCount);
+                std::memcpy(levels.data(), file.data() + internal::levels_offset(header.vertexCount, sizeof(V), header.indexCount, sizeof(T)),
+                            levels.size() * sizeof(std::uint64_t));
+                for (std::size_t level = 0; level < header.levelCount; ++level)
+                    mesh.ranges.push_back(graphics::IndexRange{static_cast<core::usize>(levels[2 * level]), static_cast<core::usize>(levels[2 * level + 1])});
+                mesh.sourceStatistics    = vertex_cache_statistics{header.cacheStatistics[0], header.cacheStatistics[1]};
+                mesh.processedStatistics = vertex_cache_statistics{header.cacheStatistics[2], header.cacheStatistics[3]};
+
+                mesh.boundingBox = graphics::BoundingBox{
+                    core::minmax<core::f32>{header.box[0], header.box[1]},
+                    core::minmax<core::f32>{header.box[2], header.box[3]},
+                    core::minmax<core::f32>{header.box[4], header.box[5]}
+                };
+                mesh.mapping = std::move(file);
+                if (progress != nullptr)
+                    progress->fraction.store(1.f, std::memory_order_relaxed);
+                return mesh;
+            }
+        }
+
+        load_parallel<T, V>(source.string().c_str(), mesh.parsedVertices, mesh.parsedIndices, onError, progress);
+        if ((progress != nullptr && progress->is_cancelled()) || !mesh.process(options, progress))
+            return cached_mesh{};
+        mesh.boundingBox = graphics::BoundingBox::from(mesh.parsedVertices);
+
+        std::vector<std::uint64_t> levels{};
+        for (auto const &range : mesh.ranges)
+            levels.insert(levels.end(), {static_cast<std::uint64_t>(range.first), static_cast<std::uint64_t>(range.count)});
+
+        internal::cache_header header{};
+        std::memcpy(header.magic, internal::cache_magic, sizeof(header.magic));
+        header.version      = internal::cache_version;
+        header.vertexSize   = sizeof(V);
+        header.indexSize    = sizeof(T);
+        header.vertexLayout = layout;
+        header.options      = processed;
+        header.sourceSize   = sourceSize;
+        header.sourceTime   = static_cast<std::int64_t>(sourceTime);
+        header.contentHash  = contentHash;
+        header.vertexCount  = mesh.parsedVertices.size();
+        header.indexCount   = mesh.parsedIndices.size();
+        header.levelCount   = mesh.ranges.size();
+        header.box[0]       = mesh.boundingBox.x.min;
+        header.box[1]       = mesh.boundingBox.x.max;
+        header.box[2]       = mesh.boundingBox.y.min;
+        header.box[3]       = mesh.boundingBox.y.max;
+        header.box[4]       = mesh.boundingBox.z.min;
+        header.box[5]       = mesh.boundingBox.z.max;
+
+        header.cacheStatistics[0] = mesh.sourceStatistics.acmr;
+        header.cacheStatistics[1] = mesh.sourceStatistics.atvr;
+        header.cacheStatistics[2] = mesh.processedStatistics.acmr;
+        header.cacheStatistics[3] = mesh.processedStatistics.atvr;
+
+        // written next to the final name and renamed, so a concurrent or interrupted write never leaves a torn file
+        std::filesystem::create_directories(directory, error);
+        auto const temporary = std::filesystem::path{cachePath}.concat(".tmp");
+        {
+            std::ofstream os{temporary, std::ios::binary | std::ios::trunc};
+            char const    padding[internal::cache_alignment]{};
+
+            os.write(reinterpret_cast<char const *>(&header), sizeof(header));
+            os.write(padding, static_cast<std::streamsize>(internal::vertices_offset() - sizeof(header)));
+            os.write(reinterpret_cast<char const *>(mesh.parsedVertices.data()),
+                     static_cast<std::streamsize>(mesh.parsedVertices.size() * sizeof(V)));
+            os.write(padding, static_cast<std::streamsize>(internal::indices_offset(header.vertexCount, sizeof(V)) - internal::vertices_offset() -
+                                                           mesh.parsedVertices.size() * sizeof(V)));
+            os.write(reinterpret_cast<char const *>(mesh.parsedIndices.data()),
+                     static_cast<std::streamsize>(mesh.parsedIndices.size() * sizeof(T)));
+            os.write(padding, static_cast<std::streamsize>(internal::levels_offset(header.vertexCount, sizeof(V), header.indexCount, sizeof(T)) -
+                                                           internal::indices_offset(header.vertexCount, sizeof(V)) -
+                                                           mesh.parsedIndices.size() * sizeof(T)));
+            os.write(reinterpret_cast<char const *>(levels.data()), static_cast<std::streamsize>(levels.size() * sizeof(std::uint64_t)));
+            if (!os)
+                error = std::make_error_code(std::errc::io_error);
+        }
+        if (!error)
+            std::filesystem::rename(temporary, cachePath, error);
+        if (error) {
+            std::filesystem::remove(temporary, error);
+            onError("Unable to write the mesh cache " + cachePath.string());
+        }
+
+        return mesh;
+    }
+}
+
+#endif //MICRO_UTILS_MESH_CACHE_H
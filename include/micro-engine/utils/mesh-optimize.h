@@ -0,0 +1,180 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+#ifndef MICRO_UTILS_MESH_OPTIMIZE_H
+#define MICRO_UTILS_MESH_OPTIMIZE_H
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "../core/types.h"
+
+namespace micro::obj {
+    // post-transform vertex cache size the optimizer targets and the statistics simulate, a fifo of this many entries
+    // is a conservative stand-in for the caches of current hardware
+    inline constexpr core::usize vertex_cache_size = 16;
+
+    // the loaders drop faces with out of range indices, the optimizer asserts it for everything else handed to it
+    template<std::unsigned_integral T>
+    fn indices_in_range(std::span<T const> indices, core::usize vertexCount) -> bool {
+        return std::all_of(indices.begin(), indices.end(), [&](T index) { return index < vertexCount; });
+    }
+
+    struct vertex_cache_statistics {
+        // cache misses per triangle, 3 when no vertex is ever reused and 0.5 at best for a regular grid
+        core::f32 acmr = 0.f;
+        // cache misses per referenced vertex, 1 means every vertex is transformed exactly once
+        core::f32 atvr = 0.f;
+    };
+
+    // replays the triangle list through a fifo cache of the given size
+    template<std::unsigned_integral T>
+    fn analyze_vertex_cache(std::span<T const> indices, core::usize vertexCount, core::usize cacheSize = vertex_cache_size)
+        -> vertex_cache_statistics {
+        assert(indices_in_range(indices, vertexCount));
+        if (indices.size() < 3)
+            return vertex_cache_statistics{};
+
+        // a vertex is cached while fewer than cacheSize misses happened since it was loaded
+        std::vector<core::usize> loaded(vertexCount, 0);
+        core::usize              time       = cacheSize + 1;
+        core::usize              misses     = 0;
+        core::usize              referenced = 0;
+        for (auto const index : indices) {
+            if (loaded[index] == 0)
+                ++referenced;
+            if (time - loaded[index] > cacheSize) {
+                loaded[index] = time++;
+                ++misses;
+            }
+        }
+
+        return vertex_cache_statistics{
+            static_cast<core::f32>(misses) / static_cast<core::f32>(indices.size() / 3),
+            static_cast<core::f32>(misses) / static_cast<core::f32>(referenced)
+        };
+    }
+
+    // triangle order for the post-transform cache (Sander, Nehab, Barczak, "Fast triangle reordering for vertex
+    // locality and reduced overdraw", 2007), fans around one vertex at a time and moves on to the neighbour that is
+    // still cached and has the fewest triangles left, linear in the number of triangles
+    template<std::unsigned_integral T>
+    fn optimize_vertex_cache(std::span<T const> indices, core::usize vertexCount, core::usize cacheSize = vertex_cache_size)
+        -> std::vector<T> {
+        assert(indices_in_range(indices, vertexCount));
+        auto const triangles = indices.size() / 3;
+
+        // triangles around every vertex, stored flat with vertex v spanning adjacency[offsets[v]] to offsets[v + 1]
+        std::vector<core::usize> offsets(vertexCount + 1, 0);
+        for (std::size_t i = 0; i < triangles * 3; ++i)
+            ++offsets[indices[i] + 1];
+        for (core::usize v = 0; v < vertexCount; ++v)
+            offsets[v + 1] += offsets[v];
+
+        std::vector<core::usize> adjacency(offsets.back());
+        {
+            auto cursor = std::vector<core::usize>(offsets.begin(), offsets.end() - 1);
+            for (std::size_t i = 0; i < triangles * 3; ++i)
+                adjacency[cursor[indices[i]]++] = i / 3;
+        }
+
+        std::vector<core::usize> live(vertexCount);
+        for (core::usize v = 0; v < vertexCount; ++v)
+            live[v] = offsets[v + 1] - offsets[v];
+
+        std::vector<core::usize> loaded(vertexCount, 0);
+        std::vector<bool>        emitted(triangles, false);
+        std::vector<T>           deadEnds{};
+        std::vector<T>           candidates{};
+        core::usize              time   = cacheSize + 1;
+        core::usize              cursor = 0;
+
+        std::vector<T> res{};
+        res.reserve(triangles * 3);
+
+        constexpr auto none = std::numeric_limits<core::usize>::max();
+        // a vertex that is not cached any more, the last one left unfinished, or the next one with triangles left
+        auto const skipDeadEnd = [&]() -> core::usize {
+            while (!deadEnds.empty()) {
+                auto const vertex = deadEnds.back();
+                deadEnds.pop_back();
+                if (live[vertex] > 0)
+                    return vertex;
+            }
+            for (; cursor < vertexCount; ++cursor)
+                if (live[cursor] > 0)
+                    return cursor;
+            return none;
+        };
+
+        auto fanning = vertexCount > 0 ? skipDeadEnd() : none;
+        while (fanning != none) {
+            candidates.clear();
+            for (auto a = offsets[fanning]; a < offsets[fanning + 1]; ++a) {
+                auto const triangle = adjacency[a];
+                if (emitted[triangle])
+                    continue;
+
+                for (std::size_t corner = 0; corner < 3; ++corner) {
+                    auto const vertex = indices[3 * triangle + corner];
+                    res.push_back(vertex);
+                    deadEnds.push_back(vertex);
+                    candidates.push_back(vertex);
+                    --live[vertex];
+                    if (time - loaded[vertex] > cacheSize)
+                        loaded[vertex] = time++;
+                }
+                emitted[triangle] = true;
+            }
+
+            // the candidate that stays cached through its remaining triangles and entered the cache earliest
+            auto next     = none;
+            auto priority = -1;
+            for (auto const vertex : candidates) {
+                if (live[vertex] == 0)
+                    continue;
+
+                auto score = 0;
+                if (auto const age = time - loaded[vertex]; age + 2 * live[vertex] <= cacheSize)
+                    score = static_cast<core::i32>(age);
+                if (score > priority) {
+                    priority = score;
+                    next     = vertex;
+                }
+            }
+            fanning = next != none ? next : skipDeadEnd();
+        }
+
+        return res;
+    }
+
+    // renumbers the vertices in the order the triangles first use them so fetches walk the vertex buffer forward,
+    // vertices no triangle references are dropped, indices are rewritten in place
+    template<typename V, std::unsigned_integral T>
+    fn optimize_vertex_fetch(std::span<V const> vertices, std::vector<T> &indices) -> std::vector<V> {
+        assert(indices_in_range(std::span<T const>{indices}, vertices.size()));
+        constexpr auto unused = std::numeric_limits<T>::max();
+
+        std::vector<T> remap(vertices.size(), unused);
+        std::vector<V> res{};
+        res.reserve(vertices.size());
+        for (auto &index : indices) {
+            if (remap[index] == unused) {
+                remap[index] = static_cast<T>(res.size());
+                res.push_back(vertices[index]);
+            }
+            index = remap[index];
+        }
+
+        return res;
+    }
+}
+
+#endif //MICRO_UTILS_MESH_OPTIMIZE_H
@@ -0,0 +1,326 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+#ifndef MICRO_UTILS_MESH_SIMPLIFY_H
+#define MICRO_UTILS_MESH_SIMPLIFY_H
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include "../core/types.h"
+#include "../graphics/meshlet.h"
+#include "../graphics/vertex.h"
+#include "../mathematics/linear.h"
+#include "object.h"
+
+namespace micro::obj {
+    // share of the full triangle count each coarser level aims for
+    inline constexpr std::array<core::f32, 3> lod_fractions{.5f, .25f, .1f};
+
+    // a collapse is skipped when it turns a triangle around it by more than the angle of this cosine, about 60 degrees,
+    // a test for an outright flip alone lets triangles stand on edge and the level fold over itself
+    inline constexpr core::f32 max_normal_turn_cosine = .5f;
+
+    // border edges are held in place by planes through them, this many times as heavy as the faces next to them
+    inline constexpr core::f64 border_weight = 10.;
+
+    namespace internal {
+        // sum of squared distances to a set of planes (Garland, Heckbert, "Surface simplification using quadric error
+        // metrics", 1997), a symmetric 4x4 matrix of which the upper triangle is stored
+        struct quadric {
+            core::f64 xx = 0., xy = 0., xz = 0., xw = 0., yy = 0., yz = 0., yw = 0., zz = 0., zw = 0., ww = 0.;
+
+            // the plane n . p + d = 0 with a unit normal
+            static fn plane(math::vector3<core::f64> const &n, core::f64 d, core::f64 weight) -> quadric {
+                return quadric{
+                    weight * n.x * n.x, weight * n.x * n.y, weight * n.x * n.z, weight * n.x * d,
+                    weight * n.y * n.y, weight * n.y * n.z, weight * n.y * d,
+                    weight * n.z * n.z, weight * n.z * d,
+                    weight * d * d
+                };
+            }
+
+            fn operator+=(quadric const &other) -> quadric & {
+                xx += other.xx, xy += other.xy, xz += other.xz, xw += other.xw, yy += other.yy;
+                yz += other.yz, yw += other.yw, zz += other.zz, zw += other.zw, ww += other.ww;
+                return *this;
+            }
+
+            [[nodiscard]] fn error(math::vector3<core::f32> const &p) const -> core::f64 {
+                auto const x = static_cast<core::f64>(p.x), y = static_cast<core::f64>(p.y), z = static_cast<core::f64>(p.z);
+                return xx * x * x + 2. * xy * x * y + 2. * xz * x * z + 2. * xw * x +
+                       yy * y * y + 2. * yz * y * z + 2. * yw * y +
+                       zz * z * z + 2. * zw * z +
+                       ww;
+            }
+        };
+
+        constexpr fn to_f64(math::vector3<core::f32> const &v) -> math::vector3<core::f64> {
+            return math::vector3<core::f64>{static_cast<core::f64>(v.x), static_cast<core::f64>(v.y), static_cast<core::f64>(v.z)};
+        }
+
+        // vertices that only differ in attributes other than the position are welded to the lowest index among them,
+        // otherwise every uv or normal seam would tear open when one side collapses
+        template<graphics::vertex_layout V>
+        fn weld_positions(std::span<V const> vertices) -> std::vector<core::u32> {
+            std::vector<core::u32> order(vertices.size());
+            std::iota(order.begin(), order.end(), 0u);
+
+            auto const key = [&](core::u32 v) {
+                auto const p = graphics::position_of(vertices[v]);
+                return std::tuple{p.x, p.y, p.z};
+            };
+            std::sort(order.begin(), order.end(), [&](core::u32 a, core::u32 b) { return std::tuple{key(a), a} < std::tuple{key(b), b}; });
+
+            std::vector<core::u32> res(vertices.size());
+            for (std::size_t i = 0; i < order.size(); ++i)
+                res[order[i]] = i > 0 && key(order[i]) == key(order[i - 1]) ? res[order[i - 1]] : order[i];
+            return res;
+        }
+    }
+
+    // reduces the triangle list to at most targetIndexCount indices by collapsing edges into one of their endpoints in
+    // the order of the quadric error they add, collapses are applied in passes over all edges sorted by cost, a pass
+    // locks the neighbourhood of every collapse so the flip test it ran stays valid, and skips collapses that would
+    // turn a triangle around it by more than max_normal_turn_cosine allows or lay one over another, the result indexes
+    // the same vertices, stops early when no edge can collapse any more, onPass sees the share of the reduction done
+    // after every pass and stops the simplification by returning false
+    template<graphics::vertex_layout V, std::unsigned_integral T>
+    fn simplify(std::span<V const>                vertices,
+                std::span<T const>                indices,
+                core::usize                       targetIndexCount,
+                core::Predicate<core::f32> const &onPass = [](core::f32) { return true; }) -> std::vector<T> {
+        auto const weld = internal::weld_positions(vertices);
+
+        std::vector<T> res{};
+        res.reserve(indices.size());
+        for (std::size_t first = 0; first + 2 < indices.size(); first += 3) {
+            auto const a = weld[indices[first]], b = weld[indices[first + 1]], c = weld[indices[first + 2]];
+            if (a != b && b != c && c != a)
+                res.insert(res.end(), {static_cast<T>(a), static_cast<T>(b), static_cast<T>(c)});
+        }
+        if (res.size() <= targetIndexCount)
+            return res;
+
+        std::vector<math::vector3<core::f32>> positions(vertices.size());
+        for (std::size_t v = 0; v < vertices.size(); ++v)
+            positions[v] = graphics::position_of(vertices[v]);
+
+        auto const normal = [&](T a, T b, T c) {
+            return math::cross(positions[b] - positions[a], positions[c] - positions[a]);
+        };
+
+        // area weighted planes of the faces, and a plane perpendicular to the face through every border edge
+        std::vector<internal::quadric> quadrics(vertices.size());
+        {
+            std::vector<std::array<core::u32, 3>> edges{};
+            edges.reserve(res.size());
+            for (std::size_t first = 0; first < res.size(); first += 3) {
+                auto const n    = internal::to_f64(normal(res[first], res[first + 1], res[first + 2]));
+                auto const area = math::magnitude(n);
+                if (area <= 0.)
+                    continue;
+
+                auto const unit = n / area;
+                auto const q    = internal::quadric::plane(unit, -math::dot(unit, internal::to_f64(positions[res[first]])), .5 * area);
+                for (std::size_t corner = 0; corner < 3; ++corner) {
+                    quadrics[res[first + corner]] += q;
+
+                    auto const from = static_cast<core::u32>(res[first + corner]), to = static_cast<core::u32>(res[first + (corner + 1) % 3]);
+                    edges.push_back({std::min(from, to), std::max(from, to), static_cast<core::u32>(first)});
+                }
+            }
+            std::sort(edges.begin(), edges.end());
+
+            for (std::size_t i = 0; i < edges.size(); ++i) {
+                auto const shared = (i > 0 && edges[i - 1][0] == edges[i][0] && edges[i - 1][1] == edges[i][1]) ||
+                                    (i + 1 < edges.size() && edges[i + 1][0] == edges[i][0] && edges[i + 1][1] == edges[i][1]);
+                if (shared)
+                    continue;
+
+                auto const [a, b, first] = edges[i];
+                auto const edge          = internal::to_f64(positions[b] - positions[a]);
+                auto const face          = internal::to_f64(normal(res[first], res[first + 1], res[first + 2]));
+                auto const n             = math::cross(edge, face);
+                if (auto const length = math::magnitude(n); length > 0.) {
+                    auto const unit = n / length;
+                    auto const q    = internal::quadric::plane(unit, -math::dot(unit, internal::to_f64(positions[a])), border_weight * math::dot(edge, edge));
+                    quadrics[a] += q;
+                    quadrics[b] += q;
+                }
+            }
+        }
+
+        struct collapse {
+            core::f64 cost;
+            T         from;
+            T         to;
+        };
+
+        std::vector<core::usize> offsets(vertices.size() + 1);
+        std::vector<core::usize> adjacency{};
+        std::vector<collapse>    collapses{};
+        std::vector<T>           remap(vertices.size());
+        std::vector<bool>        locked(vertices.size());
+        auto const start = res.size();
+        while (res.size() > targetIndexCount) {
+            // triangles around every vertex, stored flat like in optimize_vertex_cache
+            std::fill(offsets.begin(), offsets.end(), 0);
+            for (auto const index : res)
+                ++offsets[index + 1];
+            for (std::size_t v = 0; v < vertices.size(); ++v)
+                offsets[v + 1] += offsets[v];
+            adjacency.resize(res.size());
+            {
+                auto cursor = std::vector<core::usize>(offsets.begin(), offsets.end() - 1);
+                for (std::size_t i = 0; i < res.size(); ++i)
+                    adjacency[cursor[res[i]]++] = i / 3 * 3;
+            }
+
+            // every edge of every triangle, collapsed in the direction that costs less, an edge two triangles share is
+            // listed twice and the second copy skipped once the first locked its endpoints
+            collapses.clear();
+            for (std::size_t i = 0; i < res.size(); ++i) {
+                auto const a = std::min(res[i], res[i / 3 * 3 + (i + 1) % 3]), b = std::max(res[i], res[i / 3 * 3 + (i + 1) % 3]);
+
+                auto q = quadrics[a];
+                q += quadrics[b];
+                auto const toA = q.error(positions[a]), toB = q.error(positions[b]);
+                collapses.push_back(toB <= toA ? collapse{toB, a, b} : collapse{toA, b, a});
+            }
+            std::sort(collapses.begin(), collapses.end(), [](collapse const &x, collapse const &y) { return x.cost < y.cost; });
+
+            std::iota(remap.begin(), remap.end(), T{0});
+            std::fill(locked.begin(), locked.end(), false);
+
+            // a collapse removes the triangles on its edge, usually two
+            auto const  excess  = (res.size() - targetIndexCount) / 3;
+            core::usize removed = 0;
+            core::usize applied = 0;
+            for (auto const &[cost, from, to] : collapses) {
+                if (locked[from] || locked[to])
+                    continue;
+
+                auto        flips  = false;
+                core::usize onEdge = 0;
+                for (auto a = offsets[from]; a < offsets[from + 1] && !flips; ++a) {
+                    auto const first = adjacency[a];
+                    auto const x = res[first], y = res[first + 1], z = res[first + 2];
+                    if (x == to || y == to || z == to) {
+                        ++onEdge;
+                        continue;
+                    }
+
+                    // a triangle that was degenerate already has no side to turn from, one that becomes degenerate
+                    // is turned as far as it gets
+                    auto const moved  = [&](T v) { return v == from ? to : v; };
+                    auto const before = normal(x, y, z);
+                    auto const after  = normal(moved(x), moved(y), moved(z));
+                    auto const scale  = math::magnitude(before) * math::magnitude(after);
+                    flips             = math::dot(before, before) > 0.f &&
+                                        (scale <= 0.f || math::dot(before, after) < max_normal_turn_cosine * scale);
+                }
+                // a triangle moved onto the corners of one already around the target would lie on top of it, the
+                // way a closed surface ends up as a double sided sheet
+                for (auto a = offsets[from]; a < offsets[from + 1] && !flips; ++a) {
+                    auto const first = adjacency[a];
+                    auto const x = res[first], y = res[first + 1], z = res[first + 2];
+                    if (x == to || y == to || z == to)
+                        continue;
+
+                    auto const u = x == from ? y : x, w = z == from ? y : z;
+                    for (auto b = offsets[to]; b < offsets[to + 1] && !flips; ++b) {
+                        auto const other = adjacency[b];
+                        auto const has   = [&](T v) { return res[other] == v || res[other + 1] == v || res[other + 2] == v; };
+                        flips            = has(u) && has(w);
+                    }
+                }
+                if (flips)
+                    continue;
+
+                remap[from] = to;
+                quadrics[to] += quadrics[from];
+                for (auto const v : {from, to})
+                    for (auto a = offsets[v]; a < offsets[v + 1]; ++a)
+                        for (std::size_t corner = 0; corner < 3; ++corner)
+                            locked[res[adjacency[a] + corner]] = true;
+
+                ++applied;
+                if ((removed += onEdge) >= excess)
+                    break;
+            }
+            if (applied == 0)
+                break;
+
+            auto kept = std::size_t{0};
+            for (std::size_t first = 0; first < res.size(); first += 3) {
+                auto const a = remap[res[first]], b = remap[res[first + 1]], c = remap[res[first + 2]];
+                if (a != b && b != c && c != a) {
+                    res[kept++] = a;
+                    res[kept++] = b;
+                    res[kept++] = c;
+                }
+            }
+            res.resize(kept);
+
+            if (!onPass(static_cast<core::f32>(start - res.size()) / static_cast<core::f32>(start - targetIndexCount)))
+                break;
+        }
+
+        return res;
+    }
+
+    // appends a level simplified to each fraction of the full triangle count after the indices, every level built from
+    // the one before it, returns the range of every level starting with the full one, a level that could not be
+    // simplified any further is left out together with all coarser ones, the progress restarts from 0 and moves with the
+    // triangles every level starts from, a cancelled load returns the levels finished so far
+    template<graphics::vertex_layout V, std::unsigned_integral T>
+    fn build_lod_chain(std::span<V const>         vertices,
+                       std::vector<T> &           indices,
+                       std::span<core::f32 const> fractions = lod_fractions,
+                       load_progress *            progress  = nullptr) -> std::vector<graphics::IndexRange> {
+        std::vector<graphics::IndexRange> res{graphics::IndexRange{0, indices.size()}};
+
+        auto work = 1.f;
+        for (std::size_t i = 0; i + 1 < fractions.size(); ++i)
+            work += fractions[i];
+        auto done = 0.f;
+        if (progress != nullptr)
+            progress->fraction.store(0.f, std::memory_order_relaxed);
+
+        for (std::size_t i = 0; i < fractions.size(); ++i) {
+            if (progress != nullptr && progress->is_cancelled())
+                break;
+
+            auto const target = static_cast<core::usize>(static_cast<core::f32>(res.front().count / 3) * fractions[i]) * 3;
+            auto const share  = i == 0 ? 1.f : fractions[i - 1];
+            auto const level  = simplify(vertices, std::span<T const>{indices}.subspan(res.back().first, res.back().count), target,
+                                         [&](core::f32 reduced) {
+                                             if (progress == nullptr)
+                                                 return true;
+                                             progress->fraction.store((done + share * std::min(reduced, 1.f)) / work, std::memory_order_relaxed);
+                                             return !progress->is_cancelled();
+                                         });
+            if (level.empty() || level.size() >= res.back().count || (progress != nullptr && progress->is_cancelled()))
+                break;
+
+            res.push_back(graphics::IndexRange{indices.size(), level.size()});
+            indices.insert(indices.end(), level.begin(), level.end());
+
+            done += share;
+        }
+
+        if (progress != nullptr)
+            progress->fraction.store(1.f, std::memory_order_relaxed);
+        return res;
+    }
+}
+
+#endif //MICRO_UTILS_MESH_SIMPLIFY_H
@@ -6,30 +6,532 @@
 #define MICRO_UTILS_OBJECT_H
 
 #include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <limits>
+#include <span>
 #include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "../graphics/vertex.h"
 #include "../mathematics/linear.h"
+#include "../performance/affinity.h"
+#include "mapped-file.h"
 
 namespace micro::obj {
-    template<std::unsigned_integral T>
+    enum class load_stage : core::u8 {
+        parsing,
+        // reordering and simplifying what was parsed, the fraction restarts from 0
+        processing
+    };
+
+    // shared with a load running on another thread, the loader moves fraction from 0 to 1 and, once cancelled is set,
+    // stops early and leaves its outputs as they were
+    struct load_progress {
+        std::atomic<core::f32>  fraction{0.f};
+        std::atomic<bool>       cancelled{false};
+        std::atomic<load_stage> stage{load_stage::parsing};
+
+        fn cancel() -> void { cancelled.store(true, std::memory_order_relaxed); }
+
+        [[nodiscard]] fn is_cancelled() const -> bool { return cancelled.load(std::memory_order_relaxed); }
+    };
+
+    namespace internal {
+        // parsing covers this share of the fraction, building the vertices the rest
+        inline constexpr core::f32 parse_share = .9f;
+
+        // bytes parsed by every chunk, reported every report_interval bytes so the atomics stay off the per-line path
+        class progress_sink {
+        public:
+            static constexpr std::size_t report_interval = std::size_t{1} << 16;
+
+            progress_sink(load_progress *progress_, std::size_t total_) : progress{progress_}, total{std::max(total_, std::size_t{1})} {}
+
+            // returns false once the load is cancelled
+            fn advance(std::size_t bytes) -> bool {
+                if (progress == nullptr)
+                    return true;
+
+                auto const done = parsed.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+                progress->fraction.store(parse_share * static_cast<core::f32>(done) / static_cast<core::f32>(total), std::memory_order_relaxed);
+                return !progress->is_cancelled();
+            }
+
+        private:
+            load_progress *          progress;
+            std::size_t              total;
+            std::atomic<std::size_t> parsed{0};
+        };
+
+        // open-addressing map from an obj (v, vt, vn) index triple to the vertex it produced, linear probing over a
+        // power-of-two table kept at most half full, obj indices start at 1 so a zero position index marks an empty slot
+        template<std::unsigned_integral T>
+        class corner_map {
+        public:
+            explicit corner_map(std::size_t expected) { rehash(capacity_for(expected)); }
+
+            // the value stored for the triple and false, or the given value and true when the triple was inserted
+            fn find_or_insert(math::vector3<T> const &key, T value) -> std::pair<T, bool> {
+                if (2 * (count + 1) > slots.size())
+                    rehash(2 * slots.size());
+
+                for (auto i = hash(key) & mask;; i = (i + 1) & mask) {
+                    auto &s = slots[i];
+                    if (s.key.x == 0) {
+                        s = slot{key, value};
+                        ++count;
+                        return {value, true};
+                    }
+                    if (s.key == key)
+                        return {s.value, false};
+                }
+            }
+
+        private:
+            struct slot {
+                math::vector3<T> key{0};
+                T                value = 0;
+            };
+
+            std::vector<slot> slots{};
+            std::size_t       mask  = 0;
+            std::size_t       count = 0;
+
+            static fn capacity_for(std::size_t expected) -> std::size_t {
+                std::size_t capacity = 16;
+                while (capacity < 2 * expected)
+                    capacity *= 2;
+                return capacity;
+            }
+
+            static fn hash(math::vector3<T> const &key) -> std::size_t {
+                auto h = static_cast<std::uint64_t>(key.x) * 0x9e3779b97f4a7c15ull ^
+                         static_cast<std::uint64_t>(key.y) * 0xc2b2ae3d27d4eb4full ^
+                         static_cast<std::uint64_t>(key.z) * 0x165667b19e3779f9ull;
+                h ^= h >> 32;
+                return static_cast<std::size_t>(h);
+            }
+
+            fn rehash(std::size_t capacity) -> void {
+                auto previous = std::exchange(slots, std::vector<slot>(capacity));
+                mask          = capacity - 1;
+                count         = 0;
+                for (auto const &s : previous)
+                    if (s.key.x != 0)
+                        find_or_insert(s.key, s.value);
+            }
+        };
+
+        // the attribute lists and faces of one obj file, the corners of every face are stored back to back with face i
+        // spanning corners[faces[i]] to corners[faces[i + 1]], indices are resolved to 1-based with 0 for an absent one
+        template<std::unsigned_integral T>
+        struct records {
+            std::vector<math::vector4<core::f32>> positions{};
+            std::vector<math::vector3<core::f32>> uvs{};
+            std::vector<math::vector3<core::f32>> normals{};
+            std::vector<math::vector3<T>>         corners{};
+            std::vector<std::size_t>              faces{0};
+        };
+
+        constexpr fn is_blank(char c) -> bool { return c == ' ' || c == '\t' || c == '\r'; }
+
+        constexpr fn skip_blank(char const *it, char const *end) -> char const * {
+            while (it != end && is_blank(*it))
+                ++it;
+            return it;
+        }
+
+        // std::from_chars is locale independent and does not allocate, it rejects the leading '+' obj files may have
+        fn parse_float(char const *&it, char const *end, core::f32 &value) -> bool {
+            it = skip_blank(it, end);
+            if (it != end && *it == '+')
+                ++it;
+
+            auto const [ptr, ec] = std::from_chars(it, end, value);
+            if (ec != std::errc{})
+                return false;
+
+            it = ptr;
+            return true;
+        }
+
+        fn parse_integer(char const *&it, char const *end, std::int64_t &value) -> bool {
+            if (it != end && *it == '+')
+                ++it;
+
+            auto const [ptr, ec] = std::from_chars(it, end, value);
+            if (ec != std::errc{})
+                return false;
+
+            it = ptr;
+            return true;
+        }
+
+        // negative indices count back from the last element read so far, -1 being the last one
+        template<std::unsigned_integral T>
+        constexpr fn resolve(std::int64_t index, std::size_t count) -> T {
+            return static_cast<T>(index < 0 ? static_cast<std::int64_t>(count) + index + 1 : index);
+        }
+
+        // a relative component that counted back past the first element resolves to 0 or wraps around, it is moved out of
+        // range so drop_out_of_range reports it instead of the 0 of an absent uv or normal hiding it
+        template<std::unsigned_integral T>
+        constexpr fn past_first(math::vector3<T> corner, core::u8 components) -> math::vector3<T> {
+            constexpr auto invalid = std::numeric_limits<T>::max();
+            if ((components & 1) && corner.x == 0)
+                corner.x = invalid;
+            if ((components & 2) && corner.y == 0)
+                corner.y = invalid;
+            if ((components & 4) && corner.z == 0)
+                corner.z = invalid;
+            return corner;
+        }
+
+        // a corner whose components (bit 0 position, 1 uv, 2 normal) were relative, so resolved against the counts of the
+        // records it was parsed into rather than the whole file
+        struct relative_corner {
+            std::size_t corner;
+            core::u8    components;
+        };
+
+        // one "v", "v/vt", "v//vn" or "v/vt/vn" face corner
+        template<std::unsigned_integral T>
+        fn parse_corner(char const *&it, char const *end, records<T> const &data, math::vector3<T> &corner, core::u8 &relative) -> bool {
+            relative = 0;
+
+            std::int64_t index = 0;
+            if (!parse_integer(it, end, index) || index == 0)
+                return false;
+            corner = math::vector3<T>{resolve<T>(index, data.positions.size()), 0, 0};
+            relative |= index < 0 ? 1 : 0;
+
+            if (it == end || *it != '/')
+                return true;
+            ++it;
+
+            if (it != end && *it != '/') {
+                if (!parse_integer(it, end, index) || index == 0)
+                    return false;
+                corner.y = resolve<T>(index, data.uvs.size());
+                relative |= index < 0 ? 2 : 0;
+            }
+
+            if (it == end || *it != '/')
+                return true;
+            ++it;
+
+            if (!parse_integer(it, end, index) || index == 0)
+                return false;
+            corner.z = resolve<T>(index, data.normals.size());
+            relative |= index < 0 ? 4 : 0;
+            return true;
+        }
+
+        // parses one line without its newline, returns false when the record is malformed, relative corners are listed
+        // when the caller asks for them
+        template<std::unsigned_integral T>
+        fn parse_line(char const *it, char const *end, records<T> &data, std::vector<relative_corner> *relatives = nullptr) -> bool {
+            it = skip_blank(it, end);
+            auto const keywordBegin = it;
+            while (it != end && !is_blank(*it))
+                ++it;
+            auto const keyword = std::string_view{keywordBegin, static_cast<std::size_t>(it - keywordBegin)};
+
+            if (keyword == "v") {
+                math::vector4<core::f32> position{0.f, 0.f, 0.f, 1.f};
+                if (!parse_float(it, end, position.x) || !parse_float(it, end, position.y) || !parse_float(it, end, position.z))
+                    return false;
+                if (skip_blank(it, end) != end && !parse_float(it, end, position.w))
+                    return false;
+
+                data.positions.push_back(position);
+            }
+            else if (keyword == "vt") {
+                math::vector3<core::f32> uv{0.f};
+                if (!parse_float(it, end, uv.s))
+                    return false;
+                if (skip_blank(it, end) != end && (!parse_float(it, end, uv.t) ||
+                                                   (skip_blank(it, end) != end && !parse_float(it, end, uv.p))))
+                    return false;
+
+                data.uvs.push_back(uv);
+            }
+            else if (keyword == "vn") {
+                math::vector3<core::f32> normal{0.f};
+                if (!parse_float(it, end, normal.x) || !parse_float(it, end, normal.y) || !parse_float(it, end, normal.z))
+                    return false;
+
+                data.normals.push_back(normal);
+            }
+            else if (keyword == "f") {
+                auto const first          = data.corners.size();
+                auto const firstRelatives = relatives != nullptr ? relatives->size() : 0;
+                for (it = skip_blank(it, end); it != end; it = skip_blank(it, end)) {
+                    math::vector3<T> corner{0};
+                    core::u8         relative = 0;
+                    if (!parse_corner(it, end, data, corner, relative)) {
+                        data.corners.resize(first);
+                        if (relatives != nullptr)
+                            relatives->resize(firstRelatives);
+                        return false;
+                    }
+                    if (relative != 0 && relatives != nullptr)
+                        relatives->push_back(relative_corner{data.corners.size(), relative});
+                    else if (relative != 0)
+                        corner = past_first(corner, relative);
+                    data.corners.push_back(corner);
+                }
+                data.faces.push_back(data.corners.size());
+            }
+
+            // comments, groups, objects, materials and smoothing groups carry nothing the loader keeps
+            return true;
+        }
+
+        fn malformed(std::size_t line) -> std::string { return "Skipping malformed record on line " + std::to_string(line); }
+
+        // removes every face with a corner outside the attribute lists, which assemble would otherwise read past or hand
+        // to the index buffer, faceLines holds the line every face was read from
+        template<std::unsigned_integral T>
+        fn drop_out_of_range(records<T> &data, std::span<std::size_t const> faceLines, core::Consumer<std::string const &> const &onError) -> void {
+            auto const inRange = [&](math::vector3<T> const &corner) {
+                return corner.x >= 1 && corner.x <= data.positions.size() &&
+                       corner.y <= data.uvs.size() &&
+                       corner.z <= data.normals.size();
+            };
+
+            std::size_t kept = 0, corners = 0;
+            for (std::size_t face = 0; face + 1 < data.faces.size(); ++face) {
+                auto const first = data.faces[face], last = data.faces[face + 1];
+                if (!std::all_of(data.corners.begin() + static_cast<std::ptrdiff_t>(first), data.corners.begin() + static_cast<std::ptrdiff_t>(last), inRange)) {
+                    onError("Skipping face with an out of range index on line " + std::to_string(faceLines[face]));
+                    continue;
+                }
+
+                std::copy(data.corners.begin() + static_cast<std::ptrdiff_t>(first), data.corners.begin() + static_cast<std::ptrdiff_t>(last),
+                          data.corners.begin() + static_cast<std::ptrdiff_t>(corners));
+                corners += last - first;
+                data.faces[++kept] = corners;
+            }
+            data.corners.resize(corners);
+            data.faces.resize(kept + 1);
+        }
+
+        template<std::unsigned_integral T>
+        fn parse(std::string_view text, records<T> &data, core::Consumer<std::string const &> const &onError) -> void {
+            auto                     it   = text.data();
+            auto const               end  = text.data() + text.size();
+            std::size_t              line = 0;
+            std::vector<std::size_t> faceLines{};
+            while (it != end) {
+                ++line;
+
+                auto lineEnd = static_cast<char const *>(std::memchr(it, '\n', static_cast<std::size_t>(end - it)));
+                if (lineEnd == nullptr)
+                    lineEnd = end;
+
+                auto const faces = data.faces.size();
+                if (!parse_line(it, lineEnd, data))
+                    onError(malformed(line));
+                else if (data.faces.size() != faces)
+                    faceLines.push_back(line);
+
+                it = lineEnd == end ? end : lineEnd + 1;
+            }
+
+            drop_out_of_range(data, std::span<std::size_t const>{faceLines}, onError);
+        }
+
+        // records of one newline-aligned slice of the file, indices and line numbers are local to the slice until merged
+        template<std::unsigned_integral T>
+        struct chunk {
+            records<T>                   data{};
+            std::vector<relative_corner> relatives{};
+            std::vector<std::size_t>     errors{};
+            std::vector<std::size_t>     faceLines{};
+            std::size_t                  lines = 0;
+        };
+
+        template<std::unsigned_integral T>
+        fn parse_chunk(std::string_view text, chunk<T> &part, progress_sink *sink = nullptr) -> void {
+            auto       it       = text.data();
+            auto const end      = text.data() + text.size();
+            auto       reported = it;
+            while (it != end) {
+                if (sink != nullptr && static_cast<std::size_t>(it - reported) >= progress_sink::report_interval) {
+                    if (!sink->advance(static_cast<std::size_t>(it - reported)))
+                        return;
+                    reported = it;
+                }
+
+                ++part.lines;
+
+                auto lineEnd = static_cast<char const *>(std::memchr(it, '\n', static_cast<std::size_t>(end - it)));
+                if (lineEnd == nullptr)
+                    lineEnd = end;
+
+                auto const faces = part.data.faces.size();
+                if (!parse_line(it, lineEnd, part.data, &part.relatives))
+                    part.errors.push_back(part.lines);
+                else if (part.data.faces.size() != faces)
+                    part.faceLines.push_back(part.lines);
+
+                it = lineEnd == end ? end : lineEnd + 1;
+            }
+
+            if (sink != nullptr)
+                sink->advance(static_cast<std::size_t>(end - reported));
+        }
+
+        // concatenates the chunks in file order, every chunk is copied by its own thread into the slice the prefix sums
+        // of the earlier chunks leave for it, relative corners get the counts of the earlier chunks added, which makes
+        // them what resolving against the whole file would have given (modulo the index type, like serial parsing)
+        template<std::unsigned_integral T>
+        fn merge(std::vector<chunk<T>> const &parts, records<T> &data, core::Consumer<std::string const &> const &onError) -> void {
+            struct offsets {
+                std::size_t positions = 0, uvs = 0, normals = 0, corners = 0, faces = 0, lines = 0;
+            };
+
+            std::vector<offsets> starts(parts.size() + 1);
+            for (std::size_t i = 0; i < parts.size(); ++i) {
+                auto const &part = parts[i].data;
+                starts[i + 1]    = offsets{
+                    starts[i].positions + part.positions.size(),
+                    starts[i].uvs + part.uvs.size(),
+                    starts[i].normals + part.normals.size(),
+                    starts[i].corners + part.corners.size(),
+                    starts[i].faces + part.faces.size() - 1,
+                    starts[i].lines + parts[i].lines
+                };
+            }
+
+            auto const &total = starts.back();
+            data.positions.resize(total.positions);
+            data.uvs.resize(total.uvs);
+            data.normals.resize(total.normals);
+            data.corners.resize(total.corners);
+            data.faces.resize(total.faces + 1);
+            data.faces[0] = 0;
+            std::vector<std::size_t> faceLines(total.faces);
+
+            auto const copy = [&](std::size_t i) {
+                auto const &part  = parts[i].data;
+                auto const &start = starts[i];
+
+                std::copy(part.positions.begin(), part.positions.end(), data.positions.begin() + start.positions);
+                std::copy(part.uvs.begin(), part.uvs.end(), data.uvs.begin() + start.uvs);
+                std::copy(part.normals.begin(), part.normals.end(), data.normals.begin() + start.normals);
+                std::copy(part.corners.begin(), part.corners.end(), data.corners.begin() + start.corners);
+                for (std::size_t face = 1; face < part.faces.size(); ++face)
+                    data.faces[start.faces + face] = part.faces[face] + start.corners;
+
+                for (auto const &[corner, components] : parts[i].relatives) {
+                    auto &merged = data.corners[start.corners + corner];
+                    if (components & 1)
+                        merged.x = static_cast<T>(merged.x + start.positions);
+                    if (components & 2)
+                        merged.y = static_cast<T>(merged.y + start.uvs);
+                    if (components & 4)
+                        merged.z = static_cast<T>(merged.z + start.normals);
+                    merged = past_first(merged, components);
+                }
+
+                for (std::size_t face = 0; face < parts[i].faceLines.size(); ++face)
+                    faceLines[start.faces + face] = start.lines + parts[i].faceLines[face];
+            };
+
+            std::vector<std::thread> workers{};
+            workers.reserve(parts.size() - 1);
+            for (std::size_t i = 1; i < parts.size(); ++i)
+                workers.emplace_back(copy, i);
+            copy(0);
+            for (auto &worker : workers)
+                worker.join();
+
+            for (std::size_t i = 0; i < parts.size(); ++i)
+                for (auto const line : parts[i].errors)
+                    onError(malformed(starts[i].lines + line));
+
+            drop_out_of_range(data, std::span<std::size_t const>{faceLines}, onError);
+        }
+
+        // faces are fan-triangulated and every index is in range after drop_out_of_range, without uvs and normals every
+        // position is a vertex and the corners index them directly, otherwise every distinct (v, vt, vn) triple is one
+        // vertex, packed into the layout as it is created
+        template<std::unsigned_integral T, graphics::vertex_layout V>
+        fn assemble(records<T> const &data, std::vector<V> &vertices, std::vector<T> &indices) -> void {
+            std::size_t corners = 0;
+            for (std::size_t face = 0; face + 1 < data.faces.size(); ++face) {
+                auto const count = data.faces[face + 1] - data.faces[face];
+                corners += count > 2 ? 3 * (count - 2) : 0;
+            }
+            indices.reserve(indices.size() + corners);
+
+            auto const triangulate = [&](auto &&corner) {
+                for (std::size_t face = 0; face + 1 < data.faces.size(); ++face) {
+                    auto const first = data.faces[face];
+                    for (auto i = first + 1; i + 1 < data.faces[face + 1]; ++i) {
+                        corner(data.corners[first]);
+                        corner(data.corners[i]);
+                        corner(data.corners[i + 1]);
+                    }
+                }
+            };
+
+            if (data.uvs.empty() && data.normals.empty()) {
+                auto const base = static_cast<T>(vertices.size());
+                vertices.reserve(vertices.size() + data.positions.size());
+                for (auto const &position : data.positions)
+                    vertices.push_back(V::pack(position, math::vector3<core::f32>{0}, math::vector3<core::f32>{0}));
+                triangulate([&](math::vector3<T> const &idx) { indices.push_back(base + idx.x - 1); });
+                return;
+            }
+
+            // there are usually about as many distinct triples as the largest attribute list
+            auto const expected = std::max({data.positions.size(), data.uvs.size(), data.normals.size()});
+            vertices.reserve(vertices.size() + expected);
+
+            corner_map<T> corner_vertices{expected};
+            triangulate([&](math::vector3<T> const &idx) {
+                auto const [value, inserted] = corner_vertices.find_or_insert(idx, static_cast<T>(vertices.size()));
+                if (inserted)
+                    vertices.push_back(V::pack(
+                        data.positions[idx.x - 1],
+                        idx.y == 0 ? math::vector3<core::f32>{0} : data.uvs[idx.y - 1],
+                        idx.z == 0 ? math::vector3<core::f32>{0} : data.normals[idx.z - 1]
+                    ));
+                indices.push_back(value);
+            });
+        }
+    }
+
+    // every loader packs straight into the vertex layout, Vertex keeps all attributes and the smaller layouts of
+    // vertex.h only what their shaders read
+    template<std::unsigned_integral T, graphics::vertex_layout V = graphics::Vertex>
     auto load(core::cstring                              path,
-              std::vector<graphics::Vertex> &            vertices,
+              std::vector<V> &                           vertices,
               std::vector<T> &                           indices,
               core::Consumer<std::string const &> const &onError = [](auto const &) {}) -> void {
         std::ifstream is{path, std::ios::in};
         if (!is)
             onError("Unable to open the file!");
 
-        std::vector<math::vector4<core::f32>>      positionBuff;
-        std::vector<math::vector3<core::f32>>      uvBuff;
-        std::vector<math::vector3<core::f32>>      normalBuff;
-        std::vector<std::vector<math::vector3<T>>> idxBuff{};
+        // faces are kept flat, every corner in one array and the offset where each face starts in another
+        internal::records<T>     data{};
+        std::vector<std::size_t> faceLines{};
 
         std::string line;
+        std::size_t lineNumber = 0;
         while (std::getline(is, line)) {
+            ++lineNumber;
             std::istringstream iss{line};
 
             std::string type{};
@@ -46,7 +548,7 @@ namespace micro::obj {
                 else
                     iss >> vertex.w;
 
-                positionBuff.push_back(vertex);
+                data.positions.push_back(vertex);
             }
             else if (type == "vt") {
                 math::vector3<core::f32> uv{};
@@ -63,135 +565,117 @@ namespace micro::obj {
                         iss >> uv.p;
                 }
 
-                uvBuff.push_back(uv);
+                data.uvs.push_back(uv);
             }
             else if (type == "vn") {
                 math::vector3<core::f32> normal{};
                 iss >> normal.x >> normal.y >> normal.z;
 
-                normalBuff.push_back(normal);
+                data.normals.push_back(normal);
             }
             else if (type == "f") {
-                std::vector<math::vector3<T>> inline_idxs{};
-                if (uvBuff.empty() && normalBuff.empty()) {
-                    math::vector3<T> idx{};
-                    do {
-                        iss >> idx.x;
-                        inline_idxs.push_back(idx);
-                    }
-                    while (!iss.eof());
-                }
-                else if (normalBuff.empty()) {
-                    math::vector3<T> idx{};
-                    char             delim;
-                    do {
-                        iss >> idx.x >> delim >> idx.y;
-                        inline_idxs.push_back(idx);
-                    }
-                    while (!iss.eof());
-                }
-                else if (uvBuff.empty()) {
-                    math::vector3<T> idx{};
-                    char             delim;
-                    do {
-                        iss >> idx.x >> delim >> delim >> idx.z;
-                        inline_idxs.push_back(idx);
-                    }
-                    while (!iss.eof());
-                }
-                else {
-                    math::vector3<T> idx{};
-                    char             delim;
-                    do {
-                        iss >> idx.x >> delim >> idx.y >> delim >> idx.z;
-                        inline_idxs.push_back(idx);
-                    }
-                    while (!iss.eof());
+                // the corner format is the one the attributes read so far allow, a corner that does not parse drops the
+                // whole face
+                auto const first = data.corners.size();
+                auto const read  = [&](math::vector3<T> &idx) -> std::istream & {
+                    char delim;
+                    if (data.uvs.empty() && data.normals.empty())
+                        return iss >> idx.x;
+                    if (data.normals.empty())
+                        return iss >> idx.x >> delim >> idx.y;
+                    if (data.uvs.empty())
+                        return iss >> idx.x >> delim >> delim >> idx.z;
+                    return iss >> idx.x >> delim >> idx.y >> delim >> idx.z;
+                };
+
+                math::vector3<T> idx{};
+                while (!iss.eof() && !(iss >> std::ws).eof() && read(idx))
+                    data.corners.push_back(idx);
+                if (iss.fail()) {
+                    data.corners.resize(first);
+                    onError(internal::malformed(lineNumber));
+                    continue;
                 }
 
-                idxBuff.push_back(inline_idxs);
+                data.faces.push_back(data.corners.size());
+                faceLines.push_back(lineNumber);
             }
         }
 
         is.close();
 
-        if (uvBuff.empty() && normalBuff.empty()) {
-            std::transform(
-                positionBuff.begin(), positionBuff.end(),
-                std::back_inserter(vertices),
-                graphics::Vertex::from_position
-            );
-            for (auto const &inline_idxs : idxBuff) { for (auto const &idx : inline_idxs) { indices.push_back(idx.x - 1); } }
-        }
-        else {
-            auto indexTriangulationLoop = [&](std::function<void(math::vector3<T> const &)> const &callback) {
-                for (auto const &inline_idxs : idxBuff) {
-                    auto start = std::begin(inline_idxs);
-                    for (auto it = start;
-                         it != std::end(inline_idxs) && std::next(it, 2) < std::end(inline_idxs);
-                         it = std::next(it)) {
-                        callback(*start);
-                        callback(*std::next(it, 1));
-                        callback(*std::next(it, 2));
-                    }
-                }
-            };
+        internal::drop_out_of_range(data, std::span<std::size_t const>{faceLines}, onError);
+        internal::assemble(data, vertices, indices);
+    }
 
-            if (normalBuff.empty())
-                indexTriangulationLoop(
-                    [&](math::vector3<T> const &idx) {
-                        graphics::Vertex vertex{
-                            positionBuff.at(idx.x - 1),
-                            uvBuff.at(idx.y - 1),
-                            math::vector3<core::f32>{0},
-                            math::vector3<core::f32>{0}
-                        };
-                        auto iter = std::find(vertices.begin(), vertices.end(), vertex);
-                        if (iter == vertices.end()) {
-                            vertices.emplace_back(vertex);
-                            indices.push_back(vertices.size() - 1);
-                        }
-                        else
-                            indices.push_back(std::distance(vertices.begin(), iter));
-                    }
-                );
-            else if (uvBuff.empty())
-                indexTriangulationLoop(
-                    [&](math::vector3<T> const &idx) {
-                        graphics::Vertex vertex{
-                            positionBuff.at(idx.x - 1),
-                            math::vector3<core::f32>{0},
-                            normalBuff.at(idx.z - 1),
-                            math::vector3<core::f32>{0}
-                        };
-                        auto iter = std::find(vertices.begin(), vertices.end(), vertex);
-                        if (iter == vertices.end()) {
-                            vertices.emplace_back(vertex);
-                            indices.push_back(vertices.size() - 1);
-                        }
-                        else
-                            indices.push_back(std::distance(vertices.begin(), iter));
-                    }
-                );
-            else
-                indexTriangulationLoop(
-                    [&](math::vector3<T> const &idx) {
-                        graphics::Vertex vertex{
-                            positionBuff.at(idx.x - 1),
-                            uvBuff.at(idx.y - 1),
-                            normalBuff.at(idx.z - 1),
-                            math::vector3<core::f32>{0}
-                        };
-                        auto iter = std::find(vertices.begin(), vertices.end(), vertex);
-                        if (iter == vertices.end()) {
-                            vertices.emplace_back(vertex);
-                            indices.push_back(vertices.size() - 1);
-                        }
-                        else
-                            indices.push_back(std::distance(vertices.begin(), iter));
-                    }
-                );
+    // same result as load, the file is memory-mapped and scanned in place and numbers go through std::from_chars, so
+    // nothing is allocated per line, negative (relative) indices are supported
+    template<std::unsigned_integral T, graphics::vertex_layout V = graphics::Vertex>
+    auto load_mapped(core::cstring                              path,
+                     std::vector<V> &                           vertices,
+                     std::vector<T> &                           indices,
+                     core::Consumer<std::string const &> const &onError = [](auto const &) {}) -> void {
+        utils::mapped_file file{path};
+        if (!file.is_open()) {
+            onError("Unable to open the file!");
+            return;
+        }
+
+        internal::records<T> data{};
+        internal::parse(file.view(), data, onError);
+        file.close();
+
+        internal::assemble(data, vertices, indices);
+    }
+
+    // same result as load_mapped, the mapped file is split into newline-aligned chunks of at least minimumChunk bytes
+    // that are parsed on their own threads and merged in order, the vertex assembly that follows is serial, progress is
+    // optional
+    template<std::unsigned_integral T, graphics::vertex_layout V = graphics::Vertex>
+    auto load_parallel(core::cstring                              path,
+                       std::vector<V> &                           vertices,
+                       std::vector<T> &                           indices,
+                       core::Consumer<std::string const &> const &onError      = [](auto const &) {},
+                       load_progress *                            progress     = nullptr,
+                       std::size_t                                minimumChunk = std::size_t{1} << 20) -> void {
+        utils::mapped_file file{path};
+        if (!file.is_open()) {
+            onError("Unable to open the file!");
+            return;
+        }
+
+        auto const text  = file.view();
+        auto const count = std::max(std::size_t{1}, std::min(perf::concurrency(), text.size() / std::max(minimumChunk, std::size_t{1})));
+
+        // chunk i starts after the first newline at or past i * size / count
+        std::vector<std::size_t> bounds(count + 1, text.size());
+        bounds[0] = 0;
+        for (std::size_t i = 1; i < count; ++i) {
+            auto const newline = text.find('\n', std::max(bounds[i - 1], i * (text.size() / count)));
+            bounds[i]          = newline == std::string_view::npos ? text.size() : newline + 1;
         }
+
+        internal::progress_sink         sink{progress, text.size()};
+        std::vector<internal::chunk<T>> parts(count);
+        std::vector<std::thread>        workers{};
+        workers.reserve(count - 1);
+        for (std::size_t i = 1; i < count; ++i)
+            workers.emplace_back([&, i]() { internal::parse_chunk(text.substr(bounds[i], bounds[i + 1] - bounds[i]), parts[i], &sink); });
+        internal::parse_chunk(text.substr(bounds[0], bounds[1] - bounds[0]), parts[0], &sink);
+        for (auto &worker : workers)
+            worker.join();
+
+        if (progress != nullptr && progress->is_cancelled())
+            return;
+
+        internal::records<T> data{};
+        internal::merge(parts, data, onError);
+        parts.clear();
+        file.close();
+
+        internal::assemble(data, vertices, indices);
+        if (progress != nullptr)
+            progress->fraction.store(1.f, std::memory_order_relaxed);
     }
 }
 
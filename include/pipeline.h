@@ -38,7 +38,12 @@ auto pipeline(State &state) {
     auto const width  = static_cast<f32>(view.viewport[0]);
     auto const height = static_cast<f32>(view.viewport[1]);
 
-    matrix4x4<f32> R = matrix4x4<f32>::identity();
+    // the quaternion shader rotates positions itself, the composed quaternion is then never expanded to a matrix unless
+    // the bounding box or the cpu transform still needs one
+    auto const quaternionPath = state.ui.model.quaternionShader && state.ui.rotation.current.mode == RotationMode::Quaternion;
+
+    matrix4x4<f32>  R = matrix4x4<f32>::identity();
+    quaternion<f32> Q = quaternion<f32>::real(1.f);
     if (state.ui.model.ready && state.ui.model.boundingBoxReady) {
         auto begin = state.ui.rotation.modeRotations[state.ui.rotation.current.mode].begin();
         auto end   = state.ui.rotation.modeRotations[state.ui.rotation.current.mode].begin();
@@ -47,80 +52,219 @@ auto pipeline(State &state) {
 
         state.ui.rotation.timeNs = perf::benchmark<std::chrono::high_resolution_clock, std::chrono::nanoseconds>(
             [&]() {
-                switch (state.ui.rotation.current.mode) {
+                auto &current = state.ui.rotation.current;
+                auto  count    = static_cast<usize>(std::distance(begin, end));
+
+                // the current rotation is composed last, the whole sequence goes through the dispatched kernel
+                switch (current.mode) {
                     case RotationMode::Euler: {
-                        auto rotationsAcc = std::accumulate(
-                            begin, end,
-                            matrix4x4<f32>::identity(),
-                            [](matrix4x4<f32> const &m, Rotation const &p) { return matrix4x4<f32>::from_euler(p.compound.x, p.compound.y, p.compound.z) * m; }
-                        );
-                        R = matrix4x4<f32>::from_euler(state.ui.rotation.current.compound.x,
-                                                       state.ui.rotation.current.compound.y,
-                                                       state.ui.rotation.current.compound.z) * rotationsAcc;
+                        auto &mats = state.ui.rotation.composeMatrices;
+                        mats.resize(count + 1);
+
+                        // every stored rotation shares the current order, so it is resolved once outside the loop
+                        with_euler_order(current.order, [&](auto o) {
+                            constexpr auto order = decltype(o)::value;
+
+                            std::transform(
+                                begin, end,
+                                mats.begin(),
+                                [](Rotation const &p) { return matrix3x3<f32>::from_euler<order>(p.compound); }
+                            );
+                            mats[count] = matrix3x3<f32>::from_euler<order>(current.compound);
+                        });
+                        R = matrix4x4<f32>{compose(mats.data(), mats.size())};
                         break;
                     }
                     case RotationMode::Matrix: {
-                        auto rotationsAcc = std::accumulate(
+                        auto &mats = state.ui.rotation.composeMatrices;
+                        mats.resize(count + 1);
+
+                        // rotate() post-multiplies, R_0 * ... * R_n-1 * current, so the sequence is laid out back to
+                        // front for the kernel, which applies the first element first
+                        mats[0] = current.simple.axis != vector3<f32>{0.f}
+                                      ? affine3x4<f32>::from_rotation(current.simple.angle, current.simple.axis).rotation()
+                                      : matrix3x3<f32>::identity();
+                        std::transform(
                             begin, end,
-                            matrix4x4<f32>::identity(),
-                            [](matrix4x4<f32> const &m, Rotation const &p) { return math::rotate(m, p.simple.angle, p.simple.axis); }
+                            mats.rbegin(),
+                            [](Rotation const &p) { return affine3x4<f32>::from_rotation(p.simple.angle, p.simple.axis).rotation(); }
                         );
-                        R = state.ui.rotation.current.simple.axis != vector3<f32>{0.f}
-                                ? math::rotate(rotationsAcc, state.ui.rotation.current.simple.angle,
-                                               state.ui.rotation.current.simple.axis)
-                                : rotationsAcc;
+                        R = matrix4x4<f32>{compose(mats.data(), mats.size())};
                         break;
                     }
                     case RotationMode::Quaternion: {
-                        auto rotationsAcc = std::accumulate(
+                        auto &quats = state.ui.rotation.composeQuaternions;
+                        quats.resize(count + 1);
+
+                        std::transform(
                             begin, end,
-                            quaternion<f32>::real(1.f),
-                            [](quaternion<f32> const &q, Rotation const &p) { return quaternion<f32>::from_rotation(p.simple.angle, p.simple.axis) * q; }
-                        );
-                        R = matrix4x4<f32>::from_quaternion(
-                            state.ui.rotation.current.simple.axis != vector3<f32>{0.f}
-                                ? quaternion<f32>::from_rotation(state.ui.rotation.current.simple.angle,
-                                                                 state.ui.rotation.current.simple.axis) * rotationsAcc
-                                : rotationsAcc
+                            quats.begin(),
+                            [](Rotation const &p) { return quaternion<f32>::from_rotation(p.simple.angle, p.simple.axis); }
                         );
+                        quats[count] = current.simple.axis != vector3<f32>{0.f}
+                                           ? quaternion<f32>::from_rotation(current.simple.angle, current.simple.axis)
+                                           : quaternion<f32>::real(1.f);
+                        Q = compose(quats.data(), quats.size());
+                        if (!quaternionPath)
+                            R = matrix4x4<f32>::from_quaternion(Q);
                         break;
                     }
                 }
             }
         );
+        state.ui.rotation.kernelVariant = math::kernels()[state.ui.rotation.current.mode == RotationMode::Quaternion
+                                                               ? math::kernel::compose_quaternion
+                                                               : math::kernel::compose_matrix];
+    }
+
+    auto const drawModel       = state.ui.model.ready && state.ui.model.draw;
+    auto const drawBoundingBox = state.ui.model.boundingBoxReady && state.ui.model.drawBoundingBox;
+    auto const transformOnCpu  = state.ui.model.ready && state.ui.benchmark.transform.representation != VertexTransform::None;
+    if (quaternionPath && (drawBoundingBox || transformOnCpu))
+        R = matrix4x4<f32>::from_quaternion(Q);
+
+    if (transformOnCpu)
+        state.ui.benchmark.transform.timeNs = perf::benchmark<std::chrono::high_resolution_clock, std::chrono::nanoseconds>(
+            [&]() { transformVertices(state.ui.benchmark.transform.representation, R, state.model.positions, state.model.transformed); }
+        );
+
+    // T * R * S * C, C moves the model center to the origin
+    auto const M = affine3x4<f32>{compose_trs(translateXYZ, R, scaleXYZ, modelCenter)};
+
+    // V and P only depend on the viewport and the model bounds, their product is uploaded once per change together with
+    // the uniforms of the quaternion shader that never change between frames
+    if (state.camera.changed(view.viewport, modelCenter, modelMaxRadius)) {
+        auto const V = matrix4x4<f32>::lookAt(cameraPosition, cameraTarget, cameraUp);
+
+        auto const P = matrix4x4<f32>::perspective(fov, width > 0.f && height > 0.f ? width / height : 1, zNear, zFar);
+
+        state.camera.viewport       = view.viewport;
+        state.camera.center         = modelCenter;
+        state.camera.radius         = modelMaxRadius;
+        state.camera.viewProjection = P * V;
+
+        state.model.shader
+             .bind()
+             .uniform(Application::Shaders::Vertex::Uniforms::ViewProjection, state.camera.viewProjection)
+             .unbind();
+
+        state.model.quaternionShader
+             .bind()
+             .uniform(Application::Shaders::Vertex::Uniforms::ViewProjection, state.camera.viewProjection)
+             .uniform(Application::Shaders::Vertex::Uniforms::Translation, translateXYZ)
+             .uniform(Application::Shaders::Vertex::Uniforms::Scale, scaleXYZ)
+             .uniform(Application::Shaders::Vertex::Uniforms::Pivot, modelCenter)
+             .unbind();
+
+        state.boundingBox.shader
+             .bind()
+             .uniform(Application::Shaders::Vertex::Uniforms::ViewProjection, state.camera.viewProjection)
+             .unbind();
+
+        state.trajectory.shader
+             .bind()
+             .uniform(Application::Shaders::Vertex::Uniforms::ViewProjection, state.camera.viewProjection)
+             .unbind();
+    }
+
+    // only the rotations appended since the last frame are composed, anything else the path depends on rebuilds it
+    auto const drawTrajectory = state.ui.model.ready && state.ui.model.drawTrajectory && !state.model.positions.empty();
+    if (drawTrajectory) {
+        auto const vertex = math::min(static_cast<usize>(math::max(state.ui.model.trajectoryVertex, 0)), state.model.positions.size() - 1);
+
+        TrajectorySource source{};
+        source.mode           = state.ui.rotation.current.mode;
+        source.vertex         = vertex;
+        source.point          = state.model.positions.get(vertex);
+        source.center         = modelCenter;
+        source.translate      = translateXYZ;
+        source.scale          = scaleXYZ;
+        source.viewProjection = state.camera.viewProjection;
+        source.viewport       = state.camera.viewport;
+
+        if (state.trajectory.trajectory.update(source, state.ui.rotation.modeRotations[source.mode])) {
+            state.trajectory.vertices
+                 .bind()
+                 .fill(state.trajectory.trajectory.points(), Buffer::Usage::Dynamic)
+                 .unbind();
+
+            // rebinding the attribute refreshes the vertex count of the array
+            state.trajectory.model
+                 .bind()
+                 .buffer<vector3<f32>, f32>(
+                     state.trajectory.shader.attribute(Application::Shaders::Vertex::Attributes::Position),
+                     state.trajectory.vertices
+                 )
+                 .unbind();
+        }
+    }
+
+    // the model is centered on the translation, so its bounding sphere is seen from the camera's distance to it
+    if (drawModel) {
+        auto const maxScale = math::max(scaleXYZ.x, math::max(scaleXYZ.y, scaleXYZ.z));
+        state.model.lodDiameter = projected_diameter(modelMaxRadius * maxScale, distance(cameraPosition, translateXYZ), fov, height);
+
+        auto const last = state.model.lods.empty() ? usize{0} : state.model.lods.size() - 1;
+        state.model.lod = state.ui.model.selectLod
+                              ? select_lod(state.model.lods, state.model.lodDiameter, state.model.lod, state.ui.model.lodSelection)
+                              : math::min(static_cast<usize>(math::max(state.ui.model.forcedLod, 0)), last);
+    }
+
+    // clusters are tested in model space, the frustum planes come from P * V * M and the camera is moved by M^-1, the
+    // meshlets only cover the full level
+    auto const cullMeshlets = drawModel && state.ui.model.cullMeshlets && !state.model.meshlets.empty() && state.model.lod == 0;
+    if (cullMeshlets) {
+        auto const model = quaternionPath ? compose_trs(translateXYZ, Q, scaleXYZ, modelCenter) : M.to_matrix4x4();
+        auto const eye   = inverse_affine(model) * vector4<f32>{cameraPosition.x, cameraPosition.y, cameraPosition.z, 1.f};
+
+        state.model.drawnTriangles = cull_meshlets(
+            state.model.meshlets,
+            state.camera.viewProjection * model,
+            vector3<f32>{eye.x, eye.y, eye.z},
+            state.ui.model.meshletCulling,
+            state.model.drawRanges
+        );
     }
 
-    auto const C = translate(matrix4x4<f32>::identity(), centerXYZ);
-    auto const S = scale(matrix4x4<f32>::identity(), scaleXYZ);
-    auto const T = translate(matrix4x4<f32>::identity(), translateXYZ);
-    auto const M = T * R * S * C;
+    // the index buffer holds every level, so even the full model is drawn by range
+    auto const drawRanges = cullMeshlets || state.model.lods.empty()
+                                ? std::span<IndexRange const>{state.model.drawRanges}
+                                : std::span<IndexRange const>{&state.model.lods[state.model.lod], 1};
 
-    auto const V = matrix4x4<f32>::lookAt(cameraPosition, cameraTarget, cameraUp);
+    if (drawModel && quaternionPath) {
+        // glsl keeps the scalar part in w
+        auto const rotation = vector4<f32>{Q.x, Q.y, Q.z, Q.s};
 
-    auto const P = matrix4x4<f32>::perspective(fov, width > 0.f && height > 0.f ? width / height : 1, zNear, zFar);
+        state.model.quaternionShader
+             .bind()
+             .uniform(Application::Shaders::Vertex::Uniforms::Color, state.model.color)
+             .uniform(Application::Shaders::Vertex::Uniforms::Rotation, rotation);
 
-    if (state.ui.model.ready && state.ui.model.draw) {
+        state.model.quaternionModel
+             .bind()
+             .render(drawRanges)
+             .unbind();
+
+        state.model.quaternionShader.unbind();
+    }
+    else if (drawModel) {
         state.model.shader
              .bind()
              .uniform(Application::Shaders::Vertex::Uniforms::Color, state.model.color)
-             .uniform(Application::Shaders::Vertex::Uniforms::Model, M)
-             .uniform(Application::Shaders::Vertex::Uniforms::View, V)
-             .uniform(Application::Shaders::Vertex::Uniforms::Projection, P);
+             .uniform(Application::Shaders::Vertex::Uniforms::Model, M);
 
         state.model.model
              .bind()
-             .render()
+             .render(drawRanges)
              .unbind();
 
         state.model.shader.unbind();
     }
 
-    if (state.ui.model.boundingBoxReady && state.ui.model.drawBoundingBox) {
+    if (drawBoundingBox) {
         state.boundingBox.shader
              .bind()
-             .uniform(Application::Shaders::Vertex::Uniforms::Model, M)
-             .uniform(Application::Shaders::Vertex::Uniforms::View, V)
-             .uniform(Application::Shaders::Vertex::Uniforms::Projection, P);
+             .uniform(Application::Shaders::Vertex::Uniforms::Model, M);
 
         Model::polygon(micro::graphics::Model::Face::FrontAndBack, micro::graphics::Model::Polygon::Line);
         state.boundingBox.model
@@ -131,6 +275,17 @@ auto pipeline(State &state) {
 
         state.boundingBox.shader.unbind();
     }
+
+    if (drawTrajectory) {
+        state.trajectory.shader.bind();
+
+        state.trajectory.model
+             .bind()
+             .render(Model::Primitive::LineStrip)
+             .unbind();
+
+        state.trajectory.shader.unbind();
+    }
 }
 
 #endif //FINAL_PIPELINE_H
@@ -34,6 +34,9 @@ static fn toString(RotationMode mode) -> std::string {
 struct Rotation {
     RotationMode mode;
 
+    // only meaningful in Euler mode, the order the compound angles are applied in
+    euler_order order = euler_order::xyz;
+
     union {
         // Euler
         vector3<f32> compound;
@@ -49,9 +52,9 @@ struct Rotation {
 
     constexpr explicit Rotation(RotationMode mode, f32 angle, vector3<f32> axis);
 
-    constexpr explicit Rotation(RotationMode mode, vector3<f32> angles);
+    constexpr explicit Rotation(RotationMode mode, vector3<f32> angles, euler_order order = euler_order::xyz);
 
-    constexpr Rotation(Rotation const &rotation) : mode{rotation.mode} {
+    constexpr Rotation(Rotation const &rotation) : mode{rotation.mode}, order{rotation.order} {
         switch (mode) {
             case RotationMode::Euler:
                 compound = rotation.compound;
@@ -62,7 +65,8 @@ struct Rotation {
     }
 
     auto operator=(Rotation const &rotation) -> Rotation & {
-        mode = rotation.mode;
+        mode  = rotation.mode;
+        order = rotation.order;
         switch (mode) {
             case RotationMode::Euler:
                 compound = rotation.compound;
@@ -84,6 +88,15 @@ struct Rotation {
         }
     }
 
+    static auto from(RotationMode mode, quaternion<f32> const &quat, euler_order order = euler_order::xyz) -> Rotation;
+
+    [[nodiscard]] auto toQuaternion() const -> quaternion<f32>;
+
+    [[nodiscard]] auto toMatrix() const -> matrix4x4<f32>;
+
+    // Euler targets are expressed in the given order, re-expressing an Euler rotation keeps its orientation
+    [[nodiscard]] auto to(RotationMode mode, euler_order order = euler_order::xyz) const -> Rotation;
+
     [[nodiscard]] auto toString() const -> std::string;
 };
 
@@ -105,8 +118,65 @@ constexpr Rotation::Rotation(RotationMode mode_) {
 constexpr Rotation::Rotation(RotationMode mode_, f32 angle_, vector3<f32> axis_)
     : mode{mode_}, simple{angle_, axis_} {}
 
-constexpr Rotation::Rotation(RotationMode mode_, vector3<f32> angles)
-    : mode{mode_}, compound{angles} {}
+constexpr Rotation::Rotation(RotationMode mode_, vector3<f32> angles, euler_order order_)
+    : mode{mode_}, order{order_}, compound{angles} {}
+
+auto Rotation::from(RotationMode mode_, quaternion<f32> const &quat, euler_order order_) -> Rotation {
+    if (mode_ == RotationMode::Euler)
+        return with_euler_order(order_, [&](auto o) {
+            return Rotation{mode_, vector3<f32>::from_euler<decltype(o)::value>(quat), order_};
+        });
+
+    auto const sinHalf = math::sqrt(math::max(1.f - quat.s * quat.s, 0.f));
+    if (sinHalf < 1.e-6f)
+        return Rotation{mode_, 0.f, vector3<f32>{1.f, 0.f, 0.f}};
+
+    return Rotation{mode_,
+                    2.f * math::acos(math::clamp(quat.s, -1.f, 1.f)),
+                    vector3<f32>{quat.x, quat.y, quat.z} / sinHalf};
+}
+
+auto Rotation::toQuaternion() const -> quaternion<f32> {
+    switch (mode) {
+        default:
+        case RotationMode::Euler:
+            return with_euler_order(order, [&](auto o) { return quaternion<f32>::from_euler<decltype(o)::value>(compound); });
+        case RotationMode::Matrix:
+        case RotationMode::Quaternion:
+            return isZero()
+                       ? quaternion<f32>::real(1.f)
+                       : quaternion<f32>::from_rotation(simple.angle, simple.axis);
+    }
+}
+
+auto Rotation::toMatrix() const -> matrix4x4<f32> {
+    switch (mode) {
+        default:
+        case RotationMode::Euler:
+            return with_euler_order(order, [&](auto o) { return matrix4x4<f32>::from_euler<decltype(o)::value>(compound); });
+        case RotationMode::Matrix:
+        case RotationMode::Quaternion:
+            return isZero()
+                       ? matrix4x4<f32>::identity()
+                       : math::rotate(matrix4x4<f32>::identity(), simple.angle, simple.axis);
+    }
+}
+
+auto Rotation::to(RotationMode mode_, euler_order order_) const -> Rotation {
+    if (mode_ == RotationMode::Euler) {
+        if (mode == RotationMode::Euler && order == order_)
+            return *this;
+
+        return with_euler_order(order_, [&](auto o) {
+            return Rotation{mode_, vector3<f32>::from_euler<decltype(o)::value>(toMatrix()), order_};
+        });
+    }
+
+    if (mode != RotationMode::Euler)
+        return Rotation{mode_, simple.angle, simple.axis};
+
+    return from(mode_, toQuaternion());
+}
 
 auto Rotation::toString() const -> std::string {
     std::ostringstream oss{};
@@ -115,7 +185,7 @@ auto Rotation::toString() const -> std::string {
         default:
         case RotationMode::Euler:
             oss << std::setprecision(2)
-                << ::toString(mode)
+                << ::toString(mode) << ' ' << math::name(order)
                 << "{ "
                 << ".alpha: " << math::degrees(compound.x) << " deg (" << compound.x << " rad)" << ", "
                 << ".beta: " << math::degrees(compound.y) << " deg (" << compound.y << " rad)" << ", "
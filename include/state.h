@@ -5,13 +5,21 @@
 #ifndef FINAL_STATE_H
 #define FINAL_STATE_H
 
+#include <chrono>
+#include <future>
 #include <random>
+#include <span>
+#include <string>
+#include <vector>
 
 #include "micro-engine/micro.h"
 
+#include "comparison.h"
 #include "constants.h"
 #include "metrics.h"
 #include "rotation.h"
+#include "trajectory.h"
+#include "transform.h"
 
 using namespace micro;
 using namespace micro::core;
@@ -27,15 +35,52 @@ struct ModelState {
     Model        model{};
     vector4<f32> color{1.f};
 
+    // quaternion-native variant, its own vertex array since the position attribute location may differ
+    Shader quaternionShader;
+    Model  quaternionModel{};
+
+    // whether the last load was read from the mesh cache instead of parsing the model
+    bool cached = false;
+
+    // post-transform cache behaviour of the loaded index order and of the optimized one, equal when not optimized
+    obj::vertex_cache_statistics cacheBefore{};
+    obj::vertex_cache_statistics cacheAfter{};
+
+    // positions of the loaded model for the cpu transform path, and the buffer every transform writes into
+    soa_vector3<f32> positions{};
+    soa_vector3<f32> transformed{};
+
+    // clusters of the index buffer and the ranges of those that survived culling this frame
+    std::vector<Meshlet>    meshlets{};
+    std::vector<IndexRange> drawRanges{};
+    usize                   drawnTriangles = 0;
+
+    // the full level and the simplified ones after it in the index buffer, the one drawn and the projected size of the
+    // bounding sphere it was picked for
+    std::vector<IndexRange> lods{};
+    usize                   lod         = 0;
+    f32                     lodDiameter = 0.f;
+
+    [[nodiscard]] auto indexCount() const -> usize { return lods.empty() ? 0 : lods.front().count; }
+
     ModelState() : shader{
-        graphics::shader(
-            {
-                {Shader::Type::Vertex, Application::Shaders::Vertex::Model},
-                {Shader::Type::Fragment, Application::Shaders::Fragment::Model}
-            },
-            printAndExit
-        )
-    } {}
+                       graphics::shader(
+                           {
+                               {Shader::Type::Vertex, Application::Shaders::Vertex::Model},
+                               {Shader::Type::Fragment, Application::Shaders::Fragment::Model}
+                           },
+                           printAndExit
+                       )
+                   },
+                   quaternionShader{
+                       graphics::shader(
+                           {
+                               {Shader::Type::Vertex, Application::Shaders::Vertex::ModelQuaternion},
+                               {Shader::Type::Fragment, Application::Shaders::Fragment::Model}
+                           },
+                           printAndExit
+                       )
+                   } {}
 };
 
 struct BoundingBoxState {
@@ -56,12 +101,79 @@ struct BoundingBoxState {
     } {}
 };
 
+struct TrajectoryState {
+    Trajectory trajectory{};
+    Shader     shader{};
+    Buffer     vertices{Buffer::Target::Vertex};
+    Model      model{};
+
+    TrajectoryState() : shader{
+        graphics::shader(
+            {
+                {Shader::Type::Vertex, Application::Shaders::Vertex::Trajectory},
+                {Shader::Type::Fragment, Application::Shaders::Fragment::Trajectory}
+            },
+            printAndExit
+        )
+    } {}
+};
+
+// the model shaders read only a_position, so nothing else is loaded or uploaded, PackedPositionVertex would halve it
+// again at half precision
+using ModelVertex = PositionVertex;
+
+// what the loading thread hands back, the gl objects are built from it on the render thread
+struct LoadedModel {
+    // already reordered and holding every level of detail, the cache entry is kept per set of options
+    obj::cached_mesh<u32, ModelVertex> mesh{};
+    soa_vector3<f32>                   positions{};
+    std::vector<Meshlet>               meshlets{};
+    // collected instead of logged so the loading thread never writes to the console
+    std::vector<std::string>           warnings{};
+    // why nothing can be shown, set when the load threw or produced no triangles, the current model then stays
+    std::string                        error{};
+};
+
+// a model loading on another thread, the one loaded before keeps rendering until it is ready
+struct ModelLoadState {
+    obj::load_progress                             progress{};
+    std::future<LoadedModel>                       pending{};
+    std::string                                    path{};
+    // why the last load was dropped, cleared when the next one starts
+    std::string                                    error{};
+    std::chrono::high_resolution_clock::time_point start{};
+
+    [[nodiscard]] auto running() const -> bool { return pending.valid(); }
+
+    // the future waits for the thread when destroyed, cancelling first keeps that short
+    ~ModelLoadState() {
+        if (running())
+            progress.cancel();
+    }
+};
+
+// the view-projection and the static model uniforms are uploaded only when what they are built from changes, uniform
+// values stay with the program between frames
+struct CameraState {
+    vector2<i32>   viewport{0};
+    vector3<f32>   center{0.f};
+    f32            radius = -1.f;
+    matrix4x4<f32> viewProjection{1.f};
+
+    [[nodiscard]] auto changed(vector2<i32> const &viewport_, vector3<f32> const &center_, f32 radius_) const -> bool {
+        return viewport != viewport_ || center != center_ || radius != radius_;
+    }
+};
+
 struct State {
     struct UiState {
         bool show = true;
 
         struct ProgramSectionState {
             usize framesSinceStartup = 0;
+
+            // timings of the last autotune run, length 0 until one ran
+            autotune_result autotune{};
         }         program;
 
         struct BenchmarkSectionState {
@@ -83,8 +195,26 @@ struct State {
                 u32  secondsCount            = 1;
                 bool forceRotationsCount     = false;
                 u32  generatedRotationsCount = 0;
+
+                // what the generated rotations look like, the trace workload replays the loaded trace
+                perf::workload                     workload = perf::workload::uniform;
+                std::string                        tracePath{};
+                std::vector<perf::rotation_sample> trace{};
+                perf::workload_generator           generator{};
             }        automated;
 
+            struct ComparisonBenchmarkState {
+                std::vector<ComparisonMetric> metrics{};
+            }        comparison;
+
+            struct TransformBenchmarkState {
+                // applied to every position of the model each frame, None skips the cpu transform
+                VertexTransform               representation = VertexTransform::None;
+                std::chrono::nanoseconds::rep timeNs         = 0;
+
+                std::vector<TransformMetric> metrics{};
+            }        transform;
+
             std::vector<BenchmarkMetric> metrics{};
 
             f64                           averageRotationTime = 0.;
@@ -101,7 +231,30 @@ struct State {
             bool draw            = true;
             bool drawBoundingBox = false;
 
-            std::string path;
+            // in Quaternion mode, rotate in the vertex shader instead of building a model matrix every frame
+            bool quaternionShader = false;
+
+            // path of one vertex through every cumulative rotation of the current mode's sequence
+            bool drawTrajectory   = false;
+            i32  trajectoryVertex = 0;
+
+            // reorder triangles for the vertex cache and vertices by first use after loading, applies to the next load
+            bool optimizeVertexOrder = true;
+
+            // simplify the model to obj::lod_fractions of its triangles after loading, applies to the next load
+            bool buildLods = true;
+
+            // pick the level from the projected size of the bounding sphere, or always draw forcedLod
+            bool         selectLod = true;
+            i32          forcedLod = 0;
+            LodSelection lodSelection{};
+
+            // draw only the meshlets that intersect the view frustum and do not face away from the camera
+            bool           cullMeshlets = false;
+            MeshletCulling meshletCulling{};
+
+            std::string                   path;
+            std::chrono::nanoseconds::rep loadTimeNs = 0;
         }               model;
 
         struct RotationSectionState {
@@ -110,9 +263,43 @@ struct State {
 
             Rotation current = Rotation{RotationMode::Quaternion};
 
+            // composition input of the current frame, kept so composing the sequence does not allocate every frame
+            std::vector<quaternion<f32>> composeQuaternions{};
+            std::vector<matrix3x3<f32>>  composeMatrices{};
+            // variant of the composition kernel the last frame ran with
+            kernel_variant kernelVariant = kernel_variant::scalar;
+
+            // order of every Euler rotation, changing it re-expresses the stored ones so their orientation is kept
+            euler_order eulerOrder = euler_order::xyz;
+
             usize                                         modeRotationIndex = 0;
             std::map<RotationMode, std::vector<Rotation>> modeRotations{};
 
+            std::map<RotationMode, quaternion_accumulator<f32>> modeMeans{};
+            std::map<RotationMode, quaternion_tree<f32>>        modeIndices{};
+
+            struct AverageState {
+                quaternion<f32>               mean   = quaternion<f32>::real(1.f);
+                usize                         count  = 0;
+                std::chrono::nanoseconds::rep timeNs = 0;
+            }                                                   average;
+
+            struct NeighbourState {
+                bool  dedupe        = false;
+                f32   dedupeDegrees = .5f;
+                usize skipped       = 0;
+
+                f32 radiusDegrees = 5.f;
+                i32 count         = 5;
+
+                // rotation index -> angle to the queried rotation, only valid for the mode it was queried in
+                RotationMode                  mode = RotationMode::Quaternion;
+                std::map<usize, f32>          matches{};
+                std::chrono::nanoseconds::rep timeNs = 0;
+            }                                                   neighbours;
+
+            std::string importPath;
+
             RotationSectionState() {
                 auto vec = std::vector<Rotation>{};
                 vec.reserve(105'000);
@@ -121,6 +308,16 @@ struct State {
                     {RotationMode::Matrix, vec},
                     {RotationMode::Quaternion, vec}
                 };
+                modeMeans = std::map<RotationMode, quaternion_accumulator<f32>>{
+                    {RotationMode::Euler, {}},
+                    {RotationMode::Matrix, {}},
+                    {RotationMode::Quaternion, {}}
+                };
+                modeIndices = std::map<RotationMode, quaternion_tree<f32>>{
+                    {RotationMode::Euler, {}},
+                    {RotationMode::Matrix, {}},
+                    {RotationMode::Quaternion, {}}
+                };
             }
         } rotation;
     }     ui;
@@ -141,6 +338,12 @@ struct State {
     ModelState model;
 
     BoundingBoxState boundingBox;
+
+    TrajectoryState trajectory;
+
+    CameraState camera;
+
+    ModelLoadState load;
 };
 
 #endif //FINAL_STATE_H
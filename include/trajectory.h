@@ -0,0 +1,106 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+#ifndef FINAL_TRAJECTORY_H
+#define FINAL_TRAJECTORY_H
+
+#include <cmath>
+#include <vector>
+
+#include "micro-engine/micro.h"
+
+#include "rotation.h"
+
+using namespace micro;
+using namespace micro::core;
+using namespace micro::math;
+
+// everything the path depends on besides the rotations themselves, a change in any of it rebuilds the path
+struct TrajectorySource {
+    RotationMode   mode = RotationMode::Quaternion;
+    usize          vertex = 0;
+    vector3<f32>   point{0.f};
+    vector3<f32>   center{0.f};
+    vector3<f32>   translate{0.f};
+    vector3<f32>   scale{1.f};
+    matrix4x4<f32> viewProjection{1.f};
+    vector2<i32>   viewport{0};
+
+    [[nodiscard]] auto operator==(TrajectorySource const &source) const -> bool {
+        return mode == source.mode && vertex == source.vertex && point == source.point && center == source.center &&
+               translate == source.translate && scale == source.scale && viewProjection == source.viewProjection &&
+               viewport == source.viewport;
+    }
+};
+
+// world-space path of one model vertex through the cumulative rotations of a sequence, the orientation is carried
+// forward as a quaternion so appending k rotations costs k compositions and k transforms, a point is kept only when it
+// lands in another pixel than the last kept one, which bounds the polyline by what the viewport can show
+class Trajectory {
+public:
+    // returns true when the polyline changed and has to be uploaded again
+    auto update(TrajectorySource const &source, std::vector<Rotation> const &rotations) -> bool;
+
+    auto invalidate() -> void { valid = false; }
+
+    [[nodiscard]] auto points() const -> std::vector<vector3<f32>> const & { return polyline; }
+
+    // number of cumulative orientations the polyline was decimated from
+    [[nodiscard]] auto processed() const -> usize { return count; }
+
+private:
+    TrajectorySource          current{};
+    bool                      valid = false;
+    usize                     count = 0;
+    quaternion<f32>           orientation = quaternion<f32>::real(1.f);
+    vector2<i32>              lastPixel{0};
+    std::vector<vector3<f32>> polyline{};
+
+    auto append(quaternion<f32> const &orientation_) -> void;
+};
+
+auto Trajectory::update(TrajectorySource const &source, std::vector<Rotation> const &rotations) -> bool {
+    auto const rebuild = !valid || !(current == source) || rotations.size() < count;
+    if (!rebuild && rotations.size() == count)
+        return false;
+
+    if (rebuild) {
+        current     = source;
+        valid       = true;
+        count       = 0;
+        orientation = quaternion<f32>::real(1.f);
+        polyline.clear();
+        append(orientation);
+    }
+
+    for (; count < rotations.size(); ++count) {
+        // Euler and Quaternion sequences are composed first to last, Matrix post-multiplies (see the pipeline)
+        auto const quat = rotations[count].toQuaternion();
+        orientation     = normalize(current.mode == RotationMode::Matrix ? orientation * quat : quat * orientation);
+        append(orientation);
+    }
+
+    return true;
+}
+
+auto Trajectory::append(quaternion<f32> const &orientation_) -> void {
+    // same placement as the model, T + R * S * (p - C)
+    auto const local = current.point - current.center;
+    auto const world = current.translate + rotate(orientation_, vector3<f32>{current.scale.x * local.x, current.scale.y * local.y, current.scale.z * local.z});
+
+    auto const clip = current.viewProjection * vector4<f32>{world.x, world.y, world.z, 1.f};
+    if (clip.w > 0.f) {
+        auto const pixel = vector2<i32>{
+            static_cast<i32>(std::floor((clip.x / clip.w * .5f + .5f) * static_cast<f32>(current.viewport[0]))),
+            static_cast<i32>(std::floor((clip.y / clip.w * .5f + .5f) * static_cast<f32>(current.viewport[1])))
+        };
+        if (!polyline.empty() && pixel == lastPixel)
+            return;
+        lastPixel = pixel;
+    }
+
+    polyline.push_back(world);
+}
+
+#endif //FINAL_TRAJECTORY_H
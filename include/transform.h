@@ -0,0 +1,140 @@
+//
+// Created by kbratko on 10/19/2026.
+//
+
+#ifndef FINAL_TRANSFORM_H
+#define FINAL_TRANSFORM_H
+
+#include <array>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "micro-engine/micro.h"
+
+using namespace micro;
+using namespace micro::core;
+using namespace micro::math;
+using namespace micro::graphics;
+
+// how the composed rotation is applied to the model's positions on the cpu
+enum class VertexTransform {
+    None,
+    Quaternion,
+    Matrix3x3,
+    Matrix4x4
+};
+
+static fn toString(VertexTransform transform) -> std::string {
+    switch (transform) {
+        case VertexTransform::None:
+            return "None";
+        case VertexTransform::Quaternion:
+            return "Quaternion";
+        case VertexTransform::Matrix3x3:
+            return "Matrix3x3";
+        case VertexTransform::Matrix4x4:
+            return "Matrix4x4";
+    }
+}
+
+static constexpr std::array<VertexTransform, 3> vertexTransforms{
+    VertexTransform::Quaternion,
+    VertexTransform::Matrix3x3,
+    VertexTransform::Matrix4x4
+};
+
+// R is converted to the representation first, a handful of operations next to the per-vertex work, the quaternion is
+// applied as q * v * q^-1 per vertex rather than expanded back to a matrix
+auto transformVertices(VertexTransform         representation,
+                       matrix4x4<f32> const &  R,
+                       soa_vector3<f32> const &positions,
+                       soa_vector3<f32> &      out) -> void {
+    switch (representation) {
+        case VertexTransform::None:
+            break;
+        case VertexTransform::Quaternion:
+            sandwich(positions, quaternion<f32>{R}, out);
+            break;
+        case VertexTransform::Matrix3x3:
+            transform(positions, matrix3x3<f32>{R}, out);
+            break;
+        case VertexTransform::Matrix4x4:
+            transform(positions, R, out);
+            break;
+    }
+}
+
+struct TransformMetric {
+    std::string     model;
+    usize           vertices;
+    VertexTransform transform;
+    kernel_variant  kernel;
+    f64             medianNs;
+    f64             minNs;
+
+    friend fn operator<<(std::ostream &os, TransformMetric const &tm) -> std::ostream &;
+};
+
+fn operator<<(std::ostream &os, TransformMetric const &tm) -> std::ostream & {
+    return os << tm.model << ',' << tm.vertices << ',' << toString(tm.transform) << ',' << name(tm.kernel) << ','
+              << tm.medianNs << ',' << tm.minNs << ',' << tm.medianNs / static_cast<f64>(tm.vertices == 0 ? 1 : tm.vertices) << '\n';
+}
+
+template<vertex_layout V>
+auto positionsOf(std::span<V const> vertices, soa_vector3<f32> &positions) -> void {
+    positions.clear();
+    positions.reserve(vertices.size());
+    for (auto const &vertex : vertices)
+        positions.push_back(position_of(vertex));
+}
+
+// loads every .obj model in the directory and times each representation rotating all of its positions into one
+// reused output buffer, models are ordered by name
+auto benchmarkTransforms(std::filesystem::path const &             directory,
+                         core::Consumer<std::string const &> const &onError) -> std::vector<TransformMetric> {
+    std::vector<std::filesystem::path> paths{};
+    std::error_code                    error{};
+    for (auto const &entry : std::filesystem::directory_iterator{directory, error})
+        if (entry.is_regular_file() && entry.path().extension() == ".obj")
+            paths.push_back(entry.path());
+    if (error)
+        onError("Unable to list " + directory.string() + ": " + error.message());
+    std::sort(paths.begin(), paths.end());
+
+    auto const R = matrix4x4<f32>::from_quaternion(quaternion<f32>::from_rotation(radians(30.f), vector3<f32>{1.f, 2.f, 3.f}));
+
+    std::vector<TransformMetric> metrics{};
+    std::vector<PositionVertex>  vertices{};
+    std::vector<u32>             indices{};
+    soa_vector3<f32>             positions{};
+    soa_vector3<f32>             transformed{};
+    for (auto const &path : paths) {
+        vertices.clear();
+        indices.clear();
+        obj::load_parallel<u32>(path.string().c_str(), vertices, indices, onError);
+        positionsOf(std::span<PositionVertex const>{vertices}, positions);
+
+        for (auto const representation : vertexTransforms) {
+            perf::suite suite{perf::suite_options{.warmup = 1, .repetitions = 7, .minRepetitionNs = 2'000'000.}};
+            suite.run(toString(representation), [&](usize) { transformVertices(representation, R, positions, transformed); });
+
+            auto const &stats = suite.results().back().stats;
+            metrics.emplace_back(
+                TransformMetric{
+                    path.filename().string(),
+                    positions.size(),
+                    representation,
+                    kernels()[kernel::transform],
+                    stats.median,
+                    stats.min
+                }
+            );
+        }
+    }
+
+    return metrics;
+}
+
+#endif //FINAL_TRANSFORM_H
@@ -5,7 +5,11 @@
 #ifndef FINAL_UTILS_H
 #define FINAL_UTILS_H
 
+#include <algorithm>
+#include <chrono>
 #include <ctime>
+#include <fstream>
+#include <future>
 #include <iomanip>
 #include <sstream>
 #include <string>
@@ -32,35 +36,222 @@ auto printAndExit(std::string const &message) -> void {
     std::exit(EXIT_FAILURE);
 }
 
-auto loadModel(cstring                                    path,
-               ModelState &                               model, BoundingBoxState &boundingBox,
-               core::Consumer<std::string const &> const &onError) -> void {
-    std::vector<Vertex> vertices{};
-    std::vector<u32>    indices{};
-    obj::load<u32>(path, vertices, indices, onError);
+// returns false when deduplication is enabled and an equivalent rotation is already stored
+auto addRotation(State &state, Rotation const &rotation) -> bool {
+    auto const quat  = rotation.toQuaternion();
+    auto      &index = state.ui.rotation.modeIndices[rotation.mode];
+
+    if (state.ui.rotation.neighbours.dedupe &&
+        index.contains(quat, math::radians(state.ui.rotation.neighbours.dedupeDegrees))) {
+        ++state.ui.rotation.neighbours.skipped;
+        return false;
+    }
+
+    auto &rotations = state.ui.rotation.modeRotations[rotation.mode];
+    rotations.emplace_back(rotation);
+    state.ui.rotation.modeMeans[rotation.mode].add(quat);
+    index.insert(quat);
+
+    state.ui.rotation.modeRotationIndex = rotations.size() - 1;
+    return true;
+}
+
+auto popRotation(State &state, RotationMode mode) -> void {
+    auto &rotations = state.ui.rotation.modeRotations[mode];
+    if (rotations.empty())
+        return;
+
+    state.ui.rotation.modeMeans[mode].remove(rotations.back().toQuaternion());
+    state.ui.rotation.modeIndices[mode].pop_back();
+    rotations.pop_back();
+    state.ui.rotation.neighbours.matches.clear();
+    state.trajectory.trajectory.invalidate();
+
+    if (!rotations.empty())
+        state.ui.rotation.modeRotationIndex = rotations.size() - 1;
+}
+
+// re-expresses every Euler rotation, the current one included, in the given order, orientations do not change so the
+// means and indices stay valid
+auto setEulerOrder(State &state, euler_order order) -> void {
+    for (auto &rotation : state.ui.rotation.modeRotations[RotationMode::Euler])
+        rotation = rotation.to(RotationMode::Euler, order);
+
+    if (state.ui.rotation.current.mode == RotationMode::Euler)
+        state.ui.rotation.current = state.ui.rotation.current.to(RotationMode::Euler, order);
+
+    state.ui.rotation.eulerOrder = order;
+}
+
+auto clearRotations(State &state, RotationMode mode) -> void {
+    state.ui.rotation.modeRotations[mode].clear();
+    state.ui.rotation.modeMeans[mode].reset();
+    state.ui.rotation.modeIndices[mode].clear();
+    state.ui.rotation.neighbours.matches.clear();
+    state.trajectory.trajectory.invalidate();
+
+    state.ui.rotation.modeRotationIndex = 0;
+}
+
+// the Euler angles are re-expressed when the sample was taken in another order than the current one
+auto fromSample(perf::rotation_sample const &sample, RotationMode mode, euler_order order) -> Rotation {
+    return mode == RotationMode::Euler
+               ? Rotation{RotationMode::Euler, sample.euler_in(order), order}
+               : Rotation{mode, sample.angle, sample.axis};
+}
+
+auto toSample(Rotation const &rotation) -> perf::rotation_sample {
+    auto const axisAngle = rotation.to(RotationMode::Quaternion);
+
+    perf::rotation_sample sample{};
+    sample.angle = axisAngle.simple.angle;
+    sample.axis  = axisAngle.simple.axis;
+    if (rotation.mode == RotationMode::Euler) {
+        sample.euler = rotation.compound;
+        sample.order = rotation.order;
+    }
+    return sample;
+}
+
+// reads a trace in the format perf::read_trace understands, every rotation is converted to the requested mode and order
+auto loadRotations(cstring                                    path,
+                   RotationMode                               mode,
+                   euler_order                                order,
+                   core::Consumer<std::string const &> const &onError) -> std::vector<Rotation> {
+    std::vector<Rotation> rotations{};
+
+    std::ifstream is{path, std::ios::in};
+    if (!is) {
+        onError("Unable to open the file!");
+        return rotations;
+    }
+
+    for (auto const &sample : perf::read_trace(is, onError))
+        rotations.emplace_back(fromSample(sample, mode, order));
+
+    return rotations;
+}
+
+// records the rotations as a trace loadRotations and the trace workload read back
+auto saveRotations(cstring                                    path,
+                   std::vector<Rotation> const &              rotations,
+                   core::Consumer<std::string const &> const &onError) -> void {
+    std::ofstream os{path, std::ios::out};
+    if (!os) {
+        onError("Unable to open the file!");
+        return;
+    }
+
+    std::vector<perf::rotation_sample> samples(rotations.size());
+    std::transform(rotations.begin(), rotations.end(), samples.begin(), toSample);
+    perf::write_trace(os, samples);
+}
+
+auto averageRotations(std::vector<Rotation> const &rotations) -> quaternion<f32> {
+    // a sequence of Euler rotations shares one order, its quaternions are generated in a single batch
+    if (!rotations.empty() && rotations.front().mode == RotationMode::Euler) {
+        soa_vector3<f32> angles{};
+        angles.reserve(rotations.size());
+        for (auto const &rotation : rotations)
+            angles.push_back(rotation.compound);
+
+        soa_quaternion<f32> quats{};
+        with_euler_order(rotations.front().order, [&](auto o) { math::from_euler<decltype(o)::value>(angles, quats); });
+
+        return math::average(quats.to_aos());
+    }
+
+    std::vector<quaternion<f32>> quats(rotations.size());
+    std::transform(rotations.begin(), rotations.end(), quats.begin(),
+                   [](Rotation const &rotation) { return rotation.toQuaternion(); });
+
+    return math::average(quats);
+}
+
+// runs on the loading thread and touches no gl state, a model loaded before is read back from the mesh cache, the
+// optional reordering runs on every load since the cache keeps the order of the file
+auto loadMesh(std::string const &path, obj::load_progress &progress, bool optimize, bool buildLods) -> LoadedModel {
+    // the reordering and the levels of detail are cached along with the parsed arrays, a hit skips both
+    LoadedModel loaded{};
+    loaded.mesh = obj::load_cached<u32, ModelVertex>(
+        path.c_str(),
+        std::filesystem::temp_directory_path() / Application::Cache::Directory,
+        [&](auto const &msg) { loaded.warnings.push_back(msg); },
+        &progress,
+        obj::mesh_options{.optimize = optimize, .lodFractions = buildLods ? std::span<f32 const>{obj::lod_fractions} : std::span<f32 const>{}}
+    );
+    if (progress.is_cancelled())
+        return loaded;
+
+    // the loaders drop faces that index past the vertices, a cache file is only trusted as far as its header goes
+    if (!obj::indices_in_range(loaded.mesh.indices(), loaded.mesh.vertices().size())) {
+        loaded.error = path + " indexes past its vertices";
+        loaded.mesh  = {};
+        return loaded;
+    }
+    if (loaded.mesh.indices().size() < 3) {
+        loaded.error = path + " has no triangles to show";
+        return loaded;
+    }
+
+    // the levels of detail follow the full one in the same index buffer
+    auto const levels = loaded.mesh.levels();
+    if (levels.empty() || levels.back().first + levels.back().count > loaded.mesh.indices().size()) {
+        loaded.error = path + " has levels of detail past its indices";
+        loaded.mesh  = {};
+        return loaded;
+    }
+
+    positionsOf(loaded.mesh.vertices(), loaded.positions);
+    loaded.meshlets = build_meshlets(loaded.mesh.vertices(), loaded.mesh.indices().first(levels.front().count));
+    return loaded;
+}
+
+// the model shaders only read the position, every other attribute of a layout is left unbound
+auto positionLocation(Shader &shader) {
+    return [&shader](attribute_semantic semantic) -> GLint {
+        return semantic == attribute_semantic::position ? shader.attribute(Application::Shaders::Vertex::Attributes::Position) : -1;
+    };
+}
+
+// the render thread part of a load, the arrays go to the buffers straight from the mapping or the parsed vectors
+auto uploadModel(LoadedModel &loaded, ModelState &model, BoundingBoxState &boundingBox) -> void {
+    auto const &mesh  = loaded.mesh;
+    model.cached      = mesh.cached();
+    model.cacheBefore = mesh.source_statistics();
+    model.cacheAfter  = mesh.statistics();
+    model.positions   = std::move(loaded.positions);
+    model.meshlets    = std::move(loaded.meshlets);
+    model.drawRanges.clear();
+    model.lods.assign(mesh.levels().begin(), mesh.levels().end());
+    model.lod = 0;
 
     model.vertices = Buffer{Buffer::Target::Vertex};
     model.vertices
          .bind()
-         .fill(vertices)
+         .fill(mesh.vertices().size(), mesh.vertices().data())
          .unbind();
     model.indices = Buffer{Buffer::Target::Index};
     model.indices
          .bind()
-         .fill(indices)
+         .fill(mesh.indices().size(), mesh.indices().data())
          .unbind();
 
     model.model = Model{};
     model.model
          .bind()
-         .buffer<Vertex, &Vertex::position, vector4<f32>::dimensions, f32>(
-             model.shader.attribute(Application::Shaders::Vertex::Attributes::Position),
-             model.vertices
-         )
+         .layout<ModelVertex>(model.vertices, positionLocation(model.shader))
          .index<u32>(model.indices)
          .unbind();
 
-    boundingBox.box = BoundingBox::from(vertices);
+    model.quaternionModel = Model{};
+    model.quaternionModel
+         .bind()
+         .layout<ModelVertex>(model.vertices, positionLocation(model.quaternionShader))
+         .index<u32>(model.indices)
+         .unbind();
+
+    boundingBox.box = mesh.box();
 
     boundingBox.vertices = Buffer{Buffer::Target::Vertex};
     boundingBox.vertices
@@ -84,4 +275,59 @@ auto loadModel(cstring                                    path,
                .unbind();
 }
 
+// a load already running is left to finish, the ready flags stay set so the current model keeps rendering
+auto startModelLoad(State &state, std::string const &path) -> void {
+    if (state.load.running())
+        return;
+
+    state.load.progress.fraction.store(0.f, std::memory_order_relaxed);
+    state.load.progress.cancelled.store(false, std::memory_order_relaxed);
+    state.load.progress.stage.store(obj::load_stage::parsing, std::memory_order_relaxed);
+    state.load.error.clear();
+    state.load.path    = path;
+    state.load.start   = std::chrono::high_resolution_clock::now();
+    state.load.pending = std::async(
+        std::launch::async,
+        [&progress = state.load.progress, path, optimize = state.ui.model.optimizeVertexOrder,
+         buildLods = state.ui.model.buildLods]() {
+            // anything thrown would otherwise be rethrown by the future on the render thread
+            try {
+                return loadMesh(path, progress, optimize, buildLods);
+            }
+            catch (std::exception const &e) {
+                LoadedModel failed{};
+                failed.error = "Unable to load " + path + ": " + e.what();
+                return failed;
+            }
+        }
+    );
+}
+
+// called every frame, uploads the model once the loading thread is done, a cancelled or failed load is dropped and the
+// model loaded before keeps rendering
+auto pollModelLoad(State &state) -> void {
+    if (!state.load.running() || state.load.pending.wait_for(std::chrono::seconds{0}) != std::future_status::ready)
+        return;
+
+    auto loaded = state.load.pending.get();
+    for (auto const &warning : loaded.warnings)
+        cwarn << warning << std::endl;
+    if (state.load.progress.is_cancelled())
+        return;
+    if (!loaded.error.empty()) {
+        cerror << loaded.error << std::endl;
+        state.load.error = std::move(loaded.error);
+        return;
+    }
+
+    uploadModel(loaded, state.model, state.boundingBox);
+    state.ui.model.path       = state.load.path;
+    state.ui.model.loadTimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now() - state.load.start
+    ).count();
+
+    state.ui.model.ready            = true;
+    state.ui.model.boundingBoxReady = true;
+}
+
 #endif //FINAL_UTILS_H
@@ -12,6 +12,11 @@ auto main() -> int {
     window(Application::Window::Title, Application::Window::Width, Application::Window::Height);
     State state{};
 
+#ifdef MICRO_MATHEMATICS_AUTOTUNE
+    // the sequence is empty at startup, so the kernels are tuned for the length the rotation storage is sized for
+    state.ui.program.autotune = autotune(state.ui.rotation.modeRotations[RotationMode::Quaternion].capacity());
+#endif
+
     event.handler = []() {};
 
     view.showGui   = true;